@@ -0,0 +1,241 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#pragma once
+
+/** \file
+ * \brief Minimal perfect hash of procedure names.
+ *
+ * The tables of procedures (primitives in the run time and user
+ * procedures in the generated code) are searched by name using a
+ * "hash and displace" perfect hash: the name is first hashed to a
+ * bucket and the seed saved for that bucket gives the slot where the
+ * procedure is found. A search computes two hashes and compares one
+ * name, it never allocates memory.
+ *
+ * The same functions are used by the compiler to generate the tables
+ * of user procedures and by the run time to compute the table of
+ * primitives at compile time (constexpr) and to search both.
+ */
+
+// C++ lib
+//
+#include <cstdint>
+#include <cstddef>
+
+
+
+namespace lpp
+{
+
+
+
+/** \brief Hash \p name with \p seed.
+ *
+ * This is FNV-1a followed by the murmur3 finalizer. FNV alone only
+ * propagates changes toward the upper bits, so the low bits used to
+ * select a slot would not depend on the upper bits of the seed.
+ *
+ * \param[in] seed  The seed of the hash.
+ * \param[in] name  The null terminated name to hash.
+ *
+ * \return The hash.
+ */
+constexpr std::uint32_t perfect_hash(std::uint32_t seed, char const * name)
+{
+    std::uint32_t hash(2166136261U ^ (seed * 0x9E3779B9U));
+    for(; *name != '\0'; ++name)
+    {
+        hash ^= static_cast<unsigned char>(*name);
+        hash *= 16777619U;
+    }
+
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35U;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+
+/** \brief Compute the size of the table for \p count names.
+ *
+ * The size is a power of two at least twice \p count so seeds are
+ * quickly found for all the buckets.
+ *
+ * \param[in] count  The number of names in the table.
+ *
+ * \return The number of buckets and slots of the table.
+ */
+constexpr std::size_t perfect_hash_size(std::size_t count)
+{
+    std::size_t size(1);
+    while(size < count * 2)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+
+/** \brief Build the perfect hash of \p count names.
+ *
+ * On return, \p seeds has one seed per bucket (0 for empty buckets)
+ * and \p slots has the index plus one of the name found in each slot
+ * (0 for empty slots). Both must have perfect_hash_size(count) entries
+ * set to zero. The \p buckets scratch buffer must have \p count entries.
+ *
+ * The buckets with the most names are placed first since they are
+ * the hardest to place.
+ *
+ * \param[in] count  The number of names.
+ * \param[in] get_name  A function returning the name at a given index.
+ * \param[in,out] seeds  The seeds of each bucket.
+ * \param[in,out] slots  The name found in each slot.
+ * \param[in,out] buckets  Scratch buffer with the bucket of each name.
+ *
+ * \return true if the table was built, false if no seed could be found.
+ */
+template<typename GET_NAME, typename TABLE, typename SCRATCH>
+constexpr bool perfect_hash_build(std::size_t count, GET_NAME get_name, TABLE & seeds, TABLE & slots, SCRATCH & buckets)
+{
+    std::uint32_t const mask(static_cast<std::uint32_t>(perfect_hash_size(count) - 1));
+
+    std::size_t largest(0);
+    for(std::size_t i(0); i < count; ++i)
+    {
+        buckets[i] = perfect_hash(0, get_name(i)) & mask;
+
+        std::size_t size(0);
+        for(std::size_t j(0); j <= i; ++j)
+        {
+            if(buckets[j] == buckets[i])
+            {
+                ++size;
+            }
+        }
+        if(size > largest)
+        {
+            largest = size;
+        }
+    }
+
+    for(std::size_t size(largest); size > 0; --size)
+    {
+        for(std::size_t first(0); first < count; ++first)
+        {
+            // a bucket is placed once its seed is set; otherwise, the
+            // first name of the bucket is the first one we find at
+            // this size since we go through the names in order
+            //
+            std::uint32_t const b(buckets[first]);
+            if(seeds[b] != 0)
+            {
+                continue;
+            }
+            std::size_t found(0);
+            for(std::size_t i(first); i < count; ++i)
+            {
+                if(buckets[i] == b)
+                {
+                    ++found;
+                }
+            }
+            if(found != size)
+            {
+                continue;
+            }
+
+            for(std::uint32_t seed(1);; ++seed)
+            {
+                if(seed > 0x1000000)
+                {
+                    return false;
+                }
+
+                bool placed(true);
+                for(std::size_t i(first); i < count; ++i)
+                {
+                    if(buckets[i] == b)
+                    {
+                        std::uint32_t const s(perfect_hash(seed, get_name(i)) & mask);
+                        if(slots[s] != 0)
+                        {
+                            placed = false;
+                            break;
+                        }
+                        slots[s] = static_cast<std::uint32_t>(i + 1);
+                    }
+                }
+                if(placed)
+                {
+                    seeds[b] = seed;
+                    break;
+                }
+
+                // undo the slots this seed took
+                //
+                for(std::size_t i(first); i < count; ++i)
+                {
+                    if(buckets[i] == b)
+                    {
+                        std::uint32_t const s(perfect_hash(seed, get_name(i)) & mask);
+                        if(slots[s] == i + 1)
+                        {
+                            slots[s] = 0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/** \brief Search a perfect hash table.
+ *
+ * The function returns the only candidate for \p name. The caller must
+ * still compare the name at that index since any name, even one which
+ * is not in the table, leads to a slot.
+ *
+ * \param[in] name  The name to search.
+ * \param[in] seeds  The seeds of the buckets.
+ * \param[in] slots  The name index plus one of each slot.
+ * \param[in] size  The size of the table (a power of two).
+ *
+ * \return The index plus one of the candidate, or 0 if there is none.
+ */
+template<typename TABLE>
+constexpr std::uint32_t perfect_hash_find(char const * name, TABLE const & seeds, TABLE const & slots, std::size_t size)
+{
+    std::uint32_t const mask(static_cast<std::uint32_t>(size - 1));
+    std::uint32_t const seed(seeds[perfect_hash(0, name) & mask]);
+    if(seed == 0)
+    {
+        return 0;
+    }
+    return slots[perfect_hash(seed, name) & mask];
+}
+
+
+
+} // lpp namespace
+// vim: ts=4 sw=4 et nocindent
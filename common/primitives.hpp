@@ -0,0 +1,134 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#pragma once
+
+/** \file
+ * \brief Declarations of the primitives.
+ *
+ * The list of primitives is defined once in primitives.def. The compiler
+ * uses it to declare the primitives without having to lex and parse
+ * Logo declarations on each run and the run time uses it to build its
+ * table of primitives so the two always agree on the names, aliases,
+ * and number of arguments.
+ */
+
+// C++ lib
+//
+#include <cstdint>
+#include <cstddef>
+
+
+
+namespace lpp
+{
+
+
+
+typedef std::uint32_t               primitive_flag_t;
+
+constexpr primitive_flag_t          PRIMITIVE_PROCEDURE  = 0x00000000;
+constexpr primitive_flag_t          PRIMITIVE_FUNCTION   = 0x00000001;     // it returns something
+constexpr primitive_flag_t          PRIMITIVE_ARITHMETIC = 0x00000002;     // inline expression
+constexpr primitive_flag_t          PRIMITIVE_LOGIC      = PRIMITIVE_ARITHMETIC;
+constexpr primitive_flag_t          PRIMITIVE_CONTROL    = 0x00000004;     // code generated by the compiler
+constexpr primitive_flag_t          PRIMITIVE_INLINE     = 0x00000008;
+constexpr primitive_flag_t          PRIMITIVE_ARGUMENTS  = 0x00000010;     // also has an entry point with an array of arguments
+
+
+struct primitive_declaration_t
+{
+    char const *                    f_name = nullptr;
+    char const *                    f_alias = nullptr;
+    primitive_flag_t                f_flags = PRIMITIVE_PROCEDURE;
+    char const *                    f_arguments = "";
+    std::int32_t                    f_default_args = -1;            // -1 means the number of required arguments
+};
+
+
+constexpr primitive_declaration_t   g_primitive_declarations[] =
+{
+#define LPP_PRIMITIVE(name, alias, flags, arguments, default_args, function) \
+    { name, alias, flags, arguments, default_args },
+#include "primitives.def"
+#undef LPP_PRIMITIVE
+};
+
+constexpr std::size_t               PRIMITIVE_DECLARATION_COUNT = sizeof(g_primitive_declarations) / sizeof(g_primitive_declarations[0]);
+
+
+/** \brief Number of arguments of a primitive.
+ *
+ * The arguments of a primitive are written as in a Logo declaration:
+ * `:name` for a required argument, `[:name default]` for an optional
+ * argument and `[:name]` for the rest.
+ */
+struct primitive_arguments_t
+{
+    std::uint32_t                   f_required = 0;
+    std::uint32_t                   f_optional = 0;
+    bool                            f_rest = false;
+};
+
+
+/** \brief Count the arguments of a primitive.
+ *
+ * \param[in] arguments  The arguments as defined in primitives.def.
+ *
+ * \return The number of required and optional arguments and whether
+ * the primitive accepts a rest.
+ */
+constexpr primitive_arguments_t primitive_count_arguments(char const * arguments)
+{
+    primitive_arguments_t result;
+    for(; *arguments != '\0'; ++arguments)
+    {
+        if(*arguments == ':')
+        {
+            ++result.f_required;
+        }
+        else if(*arguments == '[')
+        {
+            // skip the name, then it is the end of the list (rest)
+            // or the default value (optional)
+            //
+            do
+            {
+                ++arguments;
+            }
+            while(*arguments != ' ' && *arguments != ']');
+            if(*arguments == ']')
+            {
+                result.f_rest = true;
+            }
+            else
+            {
+                ++result.f_optional;
+                while(*arguments != ']')
+                {
+                    ++arguments;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+
+
+} // lpp namespace
+// vim: ts=4 sw=4 et nocindent
@@ -0,0 +1,130 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// self
+//
+#include "lpp.hpp"
+
+// C++ lib
+//
+#include <unordered_map>
+
+
+
+namespace lpp
+{
+
+
+namespace
+{
+
+
+
+// the table is created on first use since the generated code interns
+// its atoms from static initializers
+//
+struct atom_table_t
+{
+    typedef std::unordered_map<std::string, lpp__atom_t>    map_t;
+    typedef std::vector<std::string const *>                names_t;
+
+    map_t                   f_atoms = map_t();
+    names_t                 f_names = names_t(1, nullptr);     // atom 0 is LPP__ATOM_NONE
+};
+
+
+atom_table_t & get_atom_table()
+{
+    static atom_table_t table;
+    return table;
+}
+
+
+
+} // no name namespace
+
+
+
+/** \brief Get the atom representing \p name.
+ *
+ * The first time a name gets interned, it is assigned a new atom.
+ * After that, the same atom is returned each time. Atoms are small
+ * integers so maps using them as their key do not have to hash or
+ * compare strings.
+ *
+ * \param[in] name  The name to intern.
+ *
+ * \return The atom of \p name.
+ */
+lpp__atom_t lpp__intern(std::string const & name)
+{
+    atom_table_t & table(get_atom_table());
+    auto const it(table.f_atoms.find(name));
+    if(it != table.f_atoms.end())
+    {
+        return it->second;
+    }
+
+    lpp__atom_t const atom(static_cast<lpp__atom_t>(table.f_names.size()));
+    auto const inserted(table.f_atoms.insert(atom_table_t::map_t::value_type(name, atom)));
+    table.f_names.push_back(&inserted.first->first);
+    return atom;
+}
+
+
+/** \brief Search for the atom of \p name.
+ *
+ * Contrary to lpp__intern(), this function does not create a new atom.
+ * When \p name was never interned, nothing can be defined with that
+ * name so LPP__ATOM_NONE is returned.
+ *
+ * \param[in] name  The name to search.
+ *
+ * \return The atom of \p name or LPP__ATOM_NONE.
+ */
+lpp__atom_t lpp__find_atom(std::string const & name)
+{
+    atom_table_t & table(get_atom_table());
+    auto const it(table.f_atoms.find(name));
+    if(it == table.f_atoms.end())
+    {
+        return LPP__ATOM_NONE;
+    }
+    return it->second;
+}
+
+
+std::string const & lpp__atom_name(lpp__atom_t atom)
+{
+    atom_table_t & table(get_atom_table());
+    if(atom == LPP__ATOM_NONE)
+    {
+        static std::string const no_name;
+        return no_name;
+    }
+    if(atom >= table.f_names.size())
+    {
+        throw std::logic_error("lpp__atom_name() called with an unknown atom.");
+    }
+    return *table.f_names[atom];
+}
+
+
+
+} // lpp namespace
+// vim: ts=4 sw=4 et nocindent
@@ -22,10 +22,12 @@
 
 // C++ lib
 //
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <set>
+#include <unordered_set>
 
 
 
@@ -41,13 +43,12 @@ namespace
 lpp__thing::map_t       g_properties = lpp__thing::map_t();
 
 
-typedef std::map<std::string, bool>    trace_t;
+typedef std::unordered_set<lpp__atom_t>    trace_t;
 trace_t                 g_trace = trace_t();
 
 
-typedef std::set<lpp__procedure_info_t const *>         procedure_list_t;
-typedef std::map<std::string, procedure_list_t>         variable_notification_t;
-typedef std::set<std::string>                           processing_notification_t;
+typedef std::set<lpp__procedure_info_t const *>                 procedure_list_t;
+typedef std::unordered_map<lpp__atom_t, procedure_list_t>       variable_notification_t;
 
 variable_notification_t     g_notifications;
 procedure_list_t            g_processing_notifications;
@@ -79,8 +80,18 @@ private:
 
 
 
-lpp__context::lpp__context(std::string const & filename, std::string const & procedure, lpp__integer_t line, bool primitive)
-    : f_filename(filename)
+lpp__context::lpp__context(
+          char const * filename
+        , char const * procedure
+        , lpp__integer_t line
+        , bool primitive
+        , lpp__atom_t const * slot_names
+        , lpp__thing * slots
+        , std::size_t slot_count)
+    : f_slot_names(slot_names)
+    , f_slots(slots)
+    , f_slot_count(slot_count)
+    , f_filename(filename)
     , f_procedure(procedure)
     , f_line(line)
     , f_primitive(primitive)
@@ -93,7 +104,7 @@ lpp__context::~lpp__context()
 }
 
 
-std::string const & lpp__context::get_filename() const
+char const * lpp__context::get_filename() const
 {
     return f_filename;
 }
@@ -101,7 +112,7 @@ std::string const & lpp__context::get_filename() const
 
 std::string lpp__context::get_procedure_name() const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context->f_primitive)
     {
         context = context->f_parent;
@@ -138,24 +149,169 @@ void lpp__context::set_global(pointer_t global)
 
 lpp__context::pointer_t lpp__context::get_global()
 {
-    return f_global.lock();
+    return f_global;
+}
+
+
+lpp__value::pointer_t lpp__context::get_slot_value(std::size_t idx) const
+{
+    lpp__value::pointer_t value(f_slots[idx].get_value());
+    if(value == nullptr)
+    {
+        throw lpp__error(this
+                       , lpp__error_code_t::ERROR_CODE_VARIABLE_NOT_SET
+                       , "error"
+                       , "thing named \"" + lpp__atom_name(f_slot_names[idx]) + " not found.");
+    }
+    return value;
+}
+
+
+void lpp__context::set_slot_value(std::size_t idx, lpp__value::pointer_t value)
+{
+    trace_make(f_slot_names[idx], value);
+    f_slots[idx].set_value(value);
+    notify(f_slot_names[idx]);
+}
+
+
+void lpp__context::set_local_slots(lpp__atom_t const * names, lpp__thing * slots, std::size_t count)
+{
+    f_local_slot_names = names;
+    f_local_slots = slots;
+    f_local_slot_count = count;
+}
+
+
+lpp__value::pointer_t lpp__context::get_local_value(std::size_t idx) const
+{
+    lpp__thing const & thing(f_local_slots[idx]);
+    if(thing.get_type() == lpp__thing_type_t::LPP__THING_TYPE_DEFAULT)
+    {
+        // LOCAL was not yet executed, so the variable is not visible yet
+        //
+        return get_thing(f_local_slot_names[idx])->get_value();
+    }
+
+    lpp__value::pointer_t value(thing.get_value());
+    if(value == nullptr)
+    {
+        throw lpp__error(this
+                       , lpp__error_code_t::ERROR_CODE_VARIABLE_NOT_SET
+                       , "error"
+                       , "thing named \"" + lpp__atom_name(f_local_slot_names[idx]) + " not found.");
+    }
+    return value;
+}
+
+
+void lpp__context::set_local_value(std::size_t idx, lpp__value::pointer_t value)
+{
+    trace_make(f_local_slot_names[idx], value);
+
+    lpp__thing & thing(f_local_slots[idx]);
+    if(thing.get_type() == lpp__thing_type_t::LPP__THING_TYPE_DEFAULT)
+    {
+        set_thing(f_local_slot_names[idx], value);
+        return;
+    }
+
+    thing.set_value(value);
+    notify(f_local_slot_names[idx]);
+}
+
+
+void lpp__context::declare_local(std::size_t idx, lpp__value::pointer_t value)
+{
+    f_local_slots[idx].set_value(value, lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);
+    notify(f_local_slot_names[idx]);
+}
+
+
+lpp__thing::pointer_t lpp__context::find_local_thing(lpp__atom_t name, bool undeclared) const
+{
+    // the arguments are in the slots, search those first
+    //
+    for(std::size_t idx(0); idx < f_slot_count; ++idx)
+    {
+        if(f_slot_names[idx] == name)
+        {
+            return f_slots + idx;
+        }
+    }
+
+    for(std::size_t idx(0); idx < f_local_slot_count; ++idx)
+    {
+        if(f_local_slot_names[idx] == name)
+        {
+            if(undeclared
+            || f_local_slots[idx].get_type() != lpp__thing_type_t::LPP__THING_TYPE_DEFAULT)
+            {
+                return f_local_slots + idx;
+            }
+            break;
+        }
+    }
+
+    auto it(f_things.find(name));
+    if(it != f_things.end())
+    {
+        // the map is mutable through the things it holds
+        //
+        return const_cast<lpp__thing *>(&it->second);
+    }
+
+    return nullptr;
 }
 
 
 lpp__thing::pointer_t lpp__context::find_thing(std::string const & name) const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    // a name which was never interned cannot be the name of a thing
+    //
+    lpp__atom_t const atom(lpp__find_atom(name));
+    if(atom == LPP__ATOM_NONE)
+    {
+        return nullptr;
+    }
+    return find_thing(atom);
+}
+
+
+lpp__thing::pointer_t lpp__context::find_thing(lpp__atom_t name) const
+{
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
-        auto it(context->f_things.find(name));
-        if(it != context->f_things.end())
+        lpp__thing::pointer_t thing(context->find_local_thing(name));
+        if(thing != nullptr)
         {
-            return it->second;
+            return thing;
         }
         context = context->f_parent;
     }
 
-    return lpp__thing::pointer_t();
+    return nullptr;
+}
+
+
+void lpp__context::set_local_thing(lpp__atom_t name, lpp__value::pointer_t value, lpp__thing_type_t type)
+{
+    lpp__thing::pointer_t thing(find_local_thing(name, true));
+    if(thing == nullptr)
+    {
+        f_things[name].set_value(value, type);
+    }
+    else if(thing->get_type() == lpp__thing_type_t::LPP__THING_TYPE_DEFAULT)
+    {
+        // declare a local slot
+        //
+        thing->set_value(value, type);
+    }
+    else
+    {
+        thing->set_value(value);
+    }
 }
 
 
@@ -165,7 +321,7 @@ lpp__thing::pointer_t lpp__context::get_thing(std::string const & name) const
     if(thing == nullptr
     || thing->get_value() == nullptr)
     {
-        throw lpp__error(shared_from_this()
+        throw lpp__error(this
                        , lpp__error_code_t::ERROR_CODE_VARIABLE_NOT_SET
                        , "error"
                        , "thing named \"" + name + " not found.");
@@ -174,7 +330,69 @@ lpp__thing::pointer_t lpp__context::get_thing(std::string const & name) const
 }
 
 
+/** \brief Get the arguments of a primitive by name.
+ *
+ * The primitives which accept an array of arguments keep their named
+ * entry point for CALL. That entry point uses this function to gather
+ * the values in the order of the declaration. The items of the
+ * :REST list, if any, are appended to the result.
+ *
+ * \param[in] names  The names of the arguments.
+ * \param[in] rest  Whether the primitive accepts a :REST list.
+ *
+ * \return The values of the arguments.
+ */
+lpp__value::vector_t lpp__context::get_arguments(std::initializer_list<char const *> names, bool rest) const
+{
+    lpp__value::vector_t args;
+    for(auto const & n : names)
+    {
+        args.push_back(get_thing(n)->get_value());
+    }
+
+    if(rest)
+    {
+        lpp__thing::pointer_t r(find_thing("rest"));
+        if(r != nullptr)
+        {
+            lpp__value::pointer_t const list(r->get_value());
+            if(list->type() != lpp__value_type_t::LPP__VALUE_TYPE_LIST)
+            {
+                throw lpp__error(this
+                               , lpp__error_code_t::ERROR_CODE_INVALID_DATUM
+                               , "logic"
+                               , "the :REST argument is expected to always be a list.");
+            }
+            args.insert(args.end(), list->get_list().begin(), list->get_list().end());
+        }
+    }
+
+    return args;
+}
+
+
+lpp__thing::pointer_t lpp__context::get_thing(lpp__atom_t name) const
+{
+    lpp__thing::pointer_t thing(find_thing(name));
+    if(thing == nullptr
+    || thing->get_value() == nullptr)
+    {
+        throw lpp__error(this
+                       , lpp__error_code_t::ERROR_CODE_VARIABLE_NOT_SET
+                       , "error"
+                       , "thing named \"" + lpp__atom_name(name) + " not found.");
+    }
+    return thing;
+}
+
+
 void lpp__context::set_thing(std::string const & name, lpp__value::pointer_t value, lpp__thing_type_t type)
+{
+    set_thing(lpp__intern(name), value, type);
+}
+
+
+void lpp__context::set_thing(lpp__atom_t name, lpp__value::pointer_t value, lpp__thing_type_t type)
 {
     switch(type)
     {
@@ -183,14 +401,11 @@ void lpp__context::set_thing(std::string const & name, lpp__value::pointer_t val
             lpp__thing::pointer_t thing(find_thing(name));
             if(thing == nullptr)
             {
-                thing = std::make_shared<lpp__thing>();
-                thing->set_value(value, lpp__thing_type_t::LPP__THING_TYPE_GLOBAL);
-                auto global(f_global.lock());
-                if(global == nullptr)
+                if(f_global == nullptr)
                 {
-                    throw std::logic_error("could not lock the global pointer.");
+                    throw std::logic_error("this context has no global pointer.");
                 }
-                global->f_things[name] = thing;
+                f_global->f_things[name].set_value(value, lpp__thing_type_t::LPP__THING_TYPE_GLOBAL);
             }
             else
             {
@@ -200,80 +415,76 @@ void lpp__context::set_thing(std::string const & name, lpp__value::pointer_t val
         break;
 
     case lpp__thing_type_t::LPP__THING_TYPE_CONTEXT:
-        {
-            auto it(f_things.find(name));
-            if(it == f_things.end())
-            {
-                lpp__thing::pointer_t thing(std::make_shared<lpp__thing>());
-                thing->set_value(value, lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
-                f_things[name] = thing;
-            }
-            else
-            {
-                it->second->set_value(value);
-            }
-        }
+        set_local_thing(name, value, lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
         break;
 
     case lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE:
         {
-            auto it(f_things.find(name));
-            if(it == f_things.end())
+            // make sure to save it in a procedure context, not primitive
+            //
+            lpp__context::pointer_t context(this);
+            while(context != nullptr)
             {
-                lpp__thing::pointer_t thing(std::make_shared<lpp__thing>());
-                thing->set_value(value, lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);
-
-                // make sure to save it in a procedure context, not primitive
-                //
-                lpp__context::pointer_t context(shared_from_this());
-                while(context != nullptr)
+                if(!context->f_primitive)
                 {
-                    if(!context->f_primitive)
-                    {
-                        context->f_things[name] = thing;
-                        break;
-                    }
-
-                    context = context->f_parent;
+                    context->set_local_thing(name, value, lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);
+                    break;
                 }
 
-                if(context == nullptr)
-                {
-                    throw std::logic_error("could not set thing \""
-                                         + name
-                                         + "\" in a procedure context.");
-                }
+                context = context->f_parent;
             }
-            else
+
+            if(context == nullptr)
             {
-                it->second->set_value(value);
+                throw std::logic_error("could not set thing \""
+                                     + lpp__atom_name(name)
+                                     + "\" in a procedure context.");
             }
         }
         break;
 
     case lpp__thing_type_t::LPP__THING_TYPE_GLOBAL:
+        if(f_global == nullptr)
         {
-            auto global(f_global.lock());
-            if(global == nullptr)
-            {
-                throw std::logic_error("could not lock the global pointer.");
-            }
-            auto it(global->f_things.find(name));
-            if(it == global->f_things.end())
-            {
-                lpp__thing::pointer_t thing(std::make_shared<lpp__thing>());
-                thing->set_value(value, lpp__thing_type_t::LPP__THING_TYPE_GLOBAL);
-                global->f_things[name] = thing;
-            }
-            else
-            {
-                it->second->set_value(value);
-            }
+            throw std::logic_error("this context has no global pointer.");
         }
+        f_global->set_local_thing(name, value, lpp__thing_type_t::LPP__THING_TYPE_GLOBAL);
         break;
 
     }
 
+    notify(name);
+}
+
+
+void lpp__context::trace_make(lpp__atom_t name, lpp__value::pointer_t value)
+{
+    // the inline MAKE and NAME skip primitive_make() so the trace
+    // has to be handled here
+    //
+    if(g_trace.empty()
+    || !is_traced(name))
+    {
+        return;
+    }
+
+    std::stringstream ss;
+    ss << "MAKE \""
+       << lpp__atom_name(name)
+       << " "
+       << value->to_string(DISPLAY_FLAG_BACKSLASHED | DISPLAY_FLAG_TYPED)
+       << "\n";
+    lpp__write_file(this, std::string(), ss.str());
+}
+
+
+void lpp__context::notify(lpp__atom_t name)
+{
+    if(g_notifications.empty())
+    {
+        return;
+    }
+
     auto it(g_notifications.find(name));
     if(it == g_notifications.end())
     {
@@ -287,7 +498,7 @@ void lpp__context::set_thing(std::string const & name, lpp__value::pointer_t val
     //       a callback not to get called if another earlier one decides
     //       to throw?)
     //
-    lpp__value::pointer_t variable_name(std::make_shared<lpp::lpp__value>(name));
+    lpp__value::pointer_t variable_name(lpp::lpp__make_value(lpp__atom_name(name)));
     procedure_list_t procedures(it->second);
     for(auto proc : procedures)
     {
@@ -299,12 +510,13 @@ void lpp__context::set_thing(std::string const & name, lpp__value::pointer_t val
 
         safe_processing sp(proc);
 
-        lpp__context::pointer_t sub_context(std::make_shared<lpp__context>(std::string(), proc->f_name, 0, false));
-        sub_context->set_thing("variablename", variable_name, lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
+        std::vector<lpp__thing> slots(proc->f_slot_count);
+        lpp__context sub_context("", proc->f_name, 0, false, proc->f_slot_names, slots.data(), proc->f_slot_count);
+        sub_context.set_thing("variablename", variable_name, lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
         lpp::lpp__value::vector_t rest;
-        sub_context->set_thing("rest", std::make_shared<lpp::lpp__value>(rest), lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
-        sub_context->attach(shared_from_this());
-        (*proc->f_procedure)(sub_context);
+        sub_context.set_thing("rest", lpp::lpp__make_value(rest), lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);
+        sub_context.attach(this);
+        (*proc->f_procedure)(&sub_context);
     }
 }
 
@@ -313,20 +525,24 @@ void lpp__context::erase_thing(std::string const & name)
 {
     // erase global variables
     //
-    auto global(f_global.lock());
-    if(global == nullptr)
+    if(f_global == nullptr)
+    {
+        throw std::logic_error("this context has no global pointer.");
+    }
+    lpp__atom_t const atom(lpp__find_atom(name));
+    if(atom == LPP__ATOM_NONE)
     {
-        throw std::logic_error("could not lock the global pointer.");
+        return;
     }
-    auto git(global->f_things.find(name));
-    if(git != global->f_things.end())
+    auto git(f_global->f_things.find(atom));
+    if(git != f_global->f_things.end())
     {
-        global->f_things.erase(git);
+        f_global->f_things.erase(git);
     }
 
     // erase properties
     //
-    auto pit(g_properties.find(name));
+    auto pit(g_properties.find(atom));
     if(pit != g_properties.end())
     {
         g_properties.erase(pit);
@@ -340,12 +556,23 @@ lpp__value::pointer_t lpp__context::get_all_thing_names() const
     //
     std::set<std::string> s;
 
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
+        for(std::size_t idx(0); idx < context->f_slot_count; ++idx)
+        {
+            s.insert(lpp__atom_name(context->f_slot_names[idx]));
+        }
+        for(std::size_t idx(0); idx < context->f_local_slot_count; ++idx)
+        {
+            if(context->f_local_slots[idx].get_type() != lpp__thing_type_t::LPP__THING_TYPE_DEFAULT)
+            {
+                s.insert(lpp__atom_name(context->f_local_slot_names[idx]));
+            }
+        }
         for(auto const & thing : context->f_things)
         {
-            s.insert(thing.first);
+            s.insert(lpp__atom_name(thing.first));
         }
 
         context = context->f_parent;
@@ -357,22 +584,22 @@ lpp__value::pointer_t lpp__context::get_all_thing_names() const
     names.reserve(s.size());
     for(auto const & n : s)
     {
-        names.push_back(std::make_shared<lpp__value>(n));
+        names.push_back(lpp__make_value(n));
     }
 
-    return std::make_shared<lpp__value>(names);
+    return lpp__make_value(names);
 }
 
 
 lpp__thing::pointer_t lpp__context::find_property(std::string const & listname) const
 {
-    auto const & it(g_properties.find(listname));
+    auto it(g_properties.find(lpp__find_atom(listname)));
     if(it != g_properties.end())
     {
-        return it->second;
+        return &it->second;
     }
 
-    return lpp__thing::pointer_t();
+    return nullptr;
 }
 
 
@@ -391,12 +618,11 @@ void lpp__context::set_property(
             return;
         }
 
-        thing = std::make_shared<lpp__thing>();
-        lpp__value::pointer_t new_prop(std::make_shared<lpp__value>());
+        lpp__value::pointer_t new_prop(lpp__make_value());
         lpp__value::map_t prop;
         new_prop->set_prop(prop);
+        thing = &g_properties[lpp__intern(listname)];
         thing->set_value(new_prop);
-        g_properties[listname] = thing;
     }
 
     lpp__value::pointer_t prop_value(thing->get_value());
@@ -418,7 +644,7 @@ void lpp__context::set_property(
                     // once the property is completely empty, remove it
                     // from the property list
                     //
-                    auto const & itrem(g_properties.find(listname));
+                    auto const & itrem(g_properties.find(lpp__find_atom(listname)));
                     g_properties.erase(itrem);
                 }
                 else
@@ -440,14 +666,24 @@ void lpp__context::set_property(
 
 lpp__value::pointer_t lpp__context::list_properties() const
 {
-    lpp__value::vector_t result;
-
+    // the property table is not sorted, present the names in order
+    //
+    std::vector<std::string> names;
+    names.reserve(g_properties.size());
     for(auto const & p : g_properties)
     {
-        result.push_back(std::make_shared<lpp__value>(p.first));
+        names.push_back(lpp__atom_name(p.first));
+    }
+    std::sort(names.begin(), names.end());
+
+    lpp__value::vector_t result;
+    result.reserve(names.size());
+    for(auto const & n : names)
+    {
+        result.push_back(lpp__make_value(n));
     }
 
-    return std::make_shared<lpp__value>(result);
+    return lpp__make_value(result);
 }
 
 
@@ -461,7 +697,7 @@ lpp__value::pointer_t lpp__context::get_returned_value() const
 {
     if(f_return_value == nullptr)
     {
-        throw lpp__error(shared_from_this()
+        throw lpp__error(this
                        , lpp__error_code_t::ERROR_CODE_OUTPUT_EXPECTED
                        , "error"
                        , "nothing was returned.");
@@ -479,7 +715,7 @@ void lpp__context::set_return_value(lpp__value::pointer_t value)
 
 void lpp__context::set_error(lpp__error const & e) const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
         if(!context->f_primitive)
@@ -495,7 +731,7 @@ void lpp__context::set_error(lpp__error const & e) const
 
 lpp__error const & lpp__context::get_error() const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
         if(!context->f_primitive)
@@ -534,7 +770,7 @@ void lpp__context::remove_last_repeat_count()
 
 lpp__integer_t lpp__context::get_repeat_count() const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
         if(!context->f_repeat_count.empty())
@@ -545,7 +781,7 @@ lpp__integer_t lpp__context::get_repeat_count() const
         context = context->f_parent;
     }
 
-    throw lpp__error(shared_from_this()
+    throw lpp__error(this
                    , lpp__error_code_t::ERROR_CODE_VARIABLE_NOT_SET
                    , "error"
                    , "no repeat count found.");
@@ -559,7 +795,7 @@ void lpp__context::set_test(test_t value)
         throw std::logic_error("set_test() called with TEST_UNDEFINED.");
     }
 
-    lpp__context::pointer_t context(shared_from_this());
+    lpp__context::pointer_t context(this);
     while(context != nullptr)
     {
         if(!context->f_primitive)
@@ -577,7 +813,7 @@ void lpp__context::set_test(test_t value)
 
 test_t lpp__context::get_test() const
 {
-    lpp__context::const_pointer_t context(shared_from_this());
+    lpp__context::const_pointer_t context(this);
     while(context != nullptr)
     {
         if(context->f_test != test_t::TEST_UNDEFINED)
@@ -588,7 +824,7 @@ test_t lpp__context::get_test() const
         context = context->f_parent;
     }
 
-    throw lpp__error(shared_from_this()
+    throw lpp__error(this
                    , lpp__error_code_t::ERROR_CODE_IFTRUE_IFFALSE_WITHOUT_TEST
                    , "error"
                    , "TEST never called, you cannot use IFTRUE or IFFALSE.");
@@ -597,7 +833,7 @@ test_t lpp__context::get_test() const
 
 void lpp__context::end_of_function_reached()
 {
-    throw lpp__error(shared_from_this()
+    throw lpp__error(this
                    , lpp::lpp__error_code_t::ERROR_CODE_OUTPUT_EXPECTED
                    , "error"
                    , "function must return, end of procedure reached instead.");
@@ -608,30 +844,33 @@ void lpp__context::set_trace(std::string const & name, bool trace)
 {
     if(trace)
     {
-        g_trace[name] = true;
+        g_trace.insert(lpp__intern(name));
     }
     else
     {
-        auto it(g_trace.find(name));
-        if(it != g_trace.end())
-        {
-            g_trace.erase(it);
-        }
+        g_trace.erase(lpp__find_atom(name));
     }
 }
 
 
-bool lpp__context::is_traced(std::string const & name) const
+bool lpp__context::is_traced(lpp__atom_t name) const
 {
     return g_trace.find(name) != g_trace.end();
 }
 
 
+bool lpp__context::is_traced(std::string const & name) const
+{
+    return is_traced(lpp__find_atom(name));
+}
+
+
 void lpp__context::trace_procedure(trace_mode_t action, lpp__value::pointer_t data)
 {
     // is this procedure being traced?
     //
-    if(!is_traced(f_procedure))
+    if(g_trace.empty()
+    || !is_traced(f_procedure))
     {
         return;
     }
@@ -643,25 +882,42 @@ void lpp__context::trace_procedure(trace_mode_t action, lpp__value::pointer_t da
         {
             ss << "CALL \""
                << f_procedure;
-            if(!f_things.empty())
+            if(f_slot_count > 0
+            || !f_things.empty())
             {
                 ss << " [";
                 bool first(true);
-                for(auto t : f_things)
-                {
-                    if(!first)
+                auto show = [&ss, &first](lpp__atom_t name, lpp__thing const & thing)
                     {
-                        ss << " ";
-                    }
-                    else
-                    {
-                        first = false;
-                    }
-                    ss << "[:"
-                       << t.first
-                       << " "
-                       << t.second->get_value()->to_string(DISPLAY_FLAG_BACKSLASHED | DISPLAY_FLAG_TYPED)
-                       << "]";
+                        if(!thing.is_set())
+                        {
+                            return;
+                        }
+                        if(!first)
+                        {
+                            ss << " ";
+                        }
+                        else
+                        {
+                            first = false;
+                        }
+                        ss << "[:"
+                           << lpp__atom_name(name)
+                           << " "
+                           << thing.get_value()->to_string(DISPLAY_FLAG_BACKSLASHED | DISPLAY_FLAG_TYPED)
+                           << "]";
+                    };
+                for(std::size_t idx(0); idx < f_slot_count; ++idx)
+                {
+                    show(f_slot_names[idx], f_slots[idx]);
+                }
+                for(std::size_t idx(0); idx < f_local_slot_count; ++idx)
+                {
+                    show(f_local_slot_names[idx], f_local_slots[idx]);
+                }
+                for(auto const & t : f_things)
+                {
+                    show(t.first, t.second);
                 }
                 ss << "]";
             }
@@ -692,7 +948,7 @@ void lpp__context::trace_procedure(trace_mode_t action, lpp__value::pointer_t da
     // output to terminal
     //
     ss << std::endl;
-    lpp__write_file(shared_from_this(), std::string(), ss.str());
+    lpp__write_file(this, std::string(), ss.str());
 }
 
 
@@ -703,17 +959,18 @@ void lpp__context::set_notify(std::string const & variable_name, std::string con
     lpp__procedure_info_t const * info(find_procedure(procedure_name));
     if(info == nullptr)
     {
-        throw lpp__error(shared_from_this()
+        throw lpp__error(this
                        , lpp__error_code_t::ERROR_CODE_UNKNOWN_PROCEDURE
                        , "error"
                        , "procedure named \"" + procedure_name + "\" not found.");
     }
 
-    auto it(g_notifications.find(variable_name));
+    lpp__atom_t const atom(lpp__intern(variable_name));
+    auto it(g_notifications.find(atom));
     if(it == g_notifications.end())
     {
         procedure_list_t list{info};
-        g_notifications[variable_name] = list;
+        g_notifications[atom] = list;
     }
     else
     {
@@ -724,7 +981,7 @@ void lpp__context::set_notify(std::string const & variable_name, std::string con
 
 void lpp__context::remove_notify(std::string const & variable_name, std::string const & procedure_name)
 {
-    auto it(g_notifications.find(variable_name));
+    auto it(g_notifications.find(lpp__find_atom(variable_name)));
     if(it != g_notifications.end())
     {
         if(procedure_name.empty())
@@ -736,7 +993,7 @@ void lpp__context::remove_notify(std::string const & variable_name, std::string
             lpp__procedure_info_t const * info(find_procedure(procedure_name));
             if(info == nullptr)
             {
-                throw lpp__error(shared_from_this()
+                throw lpp__error(this
                                , lpp__error_code_t::ERROR_CODE_UNKNOWN_PROCEDURE
                                , "error"
                                , "procedure named \"" + procedure_name + "\" not found.");
@@ -756,6 +1013,20 @@ void lpp__context::remove_notify(std::string const & variable_name, std::string
 }
 
 
+/** \brief Check whether any variable is being watched.
+ *
+ * The FOR loops keep their counter in a C++ variable. When a procedure
+ * was registered with NOTIFY, the counter has to be saved as a thing
+ * on each iteration so the notification happens and sees its value.
+ *
+ * \return true if at least one variable has a notification.
+ */
+bool lpp__context::has_notifications() const
+{
+    return !g_notifications.empty();
+}
+
+
 void lpp__context::attach(pointer_t parent)
 {
     if(f_parent != nullptr)
@@ -768,6 +1039,21 @@ void lpp__context::attach(pointer_t parent)
 }
 
 
+/** \brief Get the context ready to run its procedure again.
+ *
+ * A procedure calling itself as the last thing it does reuses its
+ * context: the generated code saves the new arguments in the slots
+ * and jumps back to the start of the procedure. The variables that
+ * the previous run created in this context are removed first.
+ */
+void lpp__context::restart()
+{
+    f_things.clear();
+    f_return_value.reset();
+    f_test = test_t::TEST_UNDEFINED;
+}
+
+
 
 
 
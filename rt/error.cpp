@@ -35,7 +35,7 @@ lpp__error::lpp__error()
 }
 
 
-lpp__error::lpp__error(lpp__context::const_pointer_t context
+lpp__error::lpp__error(lpp__context const * context
                      , lpp__error_code_t code
                      , std::string const & tag
                      , std::string const & message
@@ -52,7 +52,7 @@ lpp__error::lpp__error(lpp__context::const_pointer_t context
         f_line      = context->get_current_line();
         f_primitive = context->get_primitive_name();
 
-        std::const_pointer_cast<lpp__context>(context)->set_error(*this);
+        context->set_error(*this);
     }
 }
 
@@ -516,7 +516,7 @@ lpp__value::vector_t lpp__file_list()
 
     for(auto const & p : g_files)
     {
-        list.push_back(std::make_shared<lpp__value>(p.first));
+        list.push_back(lpp__make_value(p.first));
     }
 
     return list;
@@ -536,79 +536,79 @@ lpp__value::pointer_t lpp__file_info(lpp__context::pointer_t context, std::strin
     }
 
     lpp__value::vector_t list;
-    lpp__value::pointer_t prop(std::make_shared<lpp__value>(list));
+    lpp__value::pointer_t prop(lpp__make_value(list));
 
-    prop->add_prop("uid", std::make_shared<lpp__value>(static_cast<lpp__integer_t>(s.st_uid)));
+    prop->add_prop("uid", lpp__make_value(static_cast<lpp__integer_t>(s.st_uid)));
     passwd * pw(getpwuid(s.st_uid));
     if(pw != nullptr)
     {
-        prop->add_prop("user", std::make_shared<lpp__value>(std::string(pw->pw_name)));
+        prop->add_prop("user", lpp__make_value(std::string(pw->pw_name)));
     }
 
-    prop->add_prop("gid", std::make_shared<lpp__value>(static_cast<lpp__integer_t>(s.st_gid)));
+    prop->add_prop("gid", lpp__make_value(static_cast<lpp__integer_t>(s.st_gid)));
     group * gr(getgrgid(s.st_gid));
     if(gr != nullptr)
     {
-        prop->add_prop("user", std::make_shared<lpp__value>(std::string(gr->gr_name)));
+        prop->add_prop("user", lpp__make_value(std::string(gr->gr_name)));
     }
 
-    prop->add_prop("mode", std::make_shared<lpp__value>(static_cast<lpp__integer_t>(s.st_mode)));
+    prop->add_prop("mode", lpp__make_value(static_cast<lpp__integer_t>(s.st_mode)));
 
     lpp__value::vector_t modes;
     if(s.st_mode & S_ISUID)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("suid")));
+        modes.push_back(lpp__make_value(std::string("suid")));
     }
     if(s.st_mode & S_ISGID)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("sgid")));
+        modes.push_back(lpp__make_value(std::string("sgid")));
     }
     if(s.st_mode & S_ISVTX)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("svtx")));
+        modes.push_back(lpp__make_value(std::string("svtx")));
     }
     if(s.st_mode & S_IRUSR)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("rusr")));
+        modes.push_back(lpp__make_value(std::string("rusr")));
     }
     if(s.st_mode & S_IWUSR)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("wusr")));
+        modes.push_back(lpp__make_value(std::string("wusr")));
     }
     if(s.st_mode & S_IXUSR)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("xusr")));
+        modes.push_back(lpp__make_value(std::string("xusr")));
     }
     if(s.st_mode & S_IRGRP)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("rgrp")));
+        modes.push_back(lpp__make_value(std::string("rgrp")));
     }
     if(s.st_mode & S_IWGRP)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("wgrp")));
+        modes.push_back(lpp__make_value(std::string("wgrp")));
     }
     if(s.st_mode & S_IXGRP)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("xgrp")));
+        modes.push_back(lpp__make_value(std::string("xgrp")));
     }
     if(s.st_mode & S_IROTH)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("roth")));
+        modes.push_back(lpp__make_value(std::string("roth")));
     }
     if(s.st_mode & S_IWOTH)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("woth")));
+        modes.push_back(lpp__make_value(std::string("woth")));
     }
     if(s.st_mode & S_IXOTH)
     {
-        modes.push_back(std::make_shared<lpp__value>(std::string("xoth")));
+        modes.push_back(lpp__make_value(std::string("xoth")));
     }
-    prop->add_prop("modes", std::make_shared<lpp__value>(modes));
+    prop->add_prop("modes", lpp__make_value(modes));
 
-    prop->add_prop("size", std::make_shared<lpp__value>(static_cast<lpp__integer_t>(s.st_size)));
-    prop->add_prop("atime", std::make_shared<lpp__value>(static_cast<lpp__float_t>(s.st_atim.tv_sec) + static_cast<lpp__float_t>(s.st_atim.tv_nsec) / 1000000000.0));
-    prop->add_prop("mtime", std::make_shared<lpp__value>(static_cast<lpp__float_t>(s.st_mtim.tv_sec) + static_cast<lpp__float_t>(s.st_mtim.tv_nsec) / 1000000000.0));
-    prop->add_prop("ctime", std::make_shared<lpp__value>(static_cast<lpp__float_t>(s.st_ctim.tv_sec) + static_cast<lpp__float_t>(s.st_ctim.tv_nsec) / 1000000000.0));
+    prop->add_prop("size", lpp__make_value(static_cast<lpp__integer_t>(s.st_size)));
+    prop->add_prop("atime", lpp__make_value(static_cast<lpp__float_t>(s.st_atim.tv_sec) + static_cast<lpp__float_t>(s.st_atim.tv_nsec) / 1000000000.0));
+    prop->add_prop("mtime", lpp__make_value(static_cast<lpp__float_t>(s.st_mtim.tv_sec) + static_cast<lpp__float_t>(s.st_mtim.tv_nsec) / 1000000000.0));
+    prop->add_prop("ctime", lpp__make_value(static_cast<lpp__float_t>(s.st_ctim.tv_sec) + static_cast<lpp__float_t>(s.st_ctim.tv_nsec) / 1000000000.0));
 
     return prop;
 }
@@ -863,7 +863,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
 
         void get_expr(int count, lpp__value::vector_t list)
         {
-            list.push_back(std::make_shared<lpp__value>(std::string("(")));
+            list.push_back(lpp__make_value(std::string("(")));
             for(;;)
             {
                 std::string const word(get_word());
@@ -876,7 +876,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                 }
                 else if(word != "\n")
                 {
-                    list.push_back(std::make_shared<lpp__value>(word));
+                    list.push_back(lpp__make_value(word));
                     if(word == ")")
                     {
                         --count;
@@ -920,7 +920,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                     if(eol
                     && count == 0)
                     {
-                        return std::make_shared<lpp__value>(list);
+                        return lpp__make_value(list);
                     }
 
                     if(word.empty())
@@ -944,7 +944,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                                        , "error"
                                        , "found standalone ']' in the file named \"" + f_file->f_filename + "\".");
                     }
-                    return std::make_shared<lpp__value>(list);
+                    return lpp__make_value(list);
                 }
                 else if(word == "(")
                 {
@@ -959,7 +959,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                 }
                 else
                 {
-                    list.push_back(std::make_shared<lpp__value>(word));
+                    list.push_back(lpp__make_value(word));
                 }
             }
         }
@@ -979,9 +979,9 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
             in.f_file->f_istream->get(c);
             if(!in.f_file->f_istream)
             {
-                return std::make_shared<lpp__value>(static_cast<lpp__integer_t>(-1));
+                return lpp__make_value(static_cast<lpp__integer_t>(-1));
             }
-            return std::make_shared<lpp__value>(static_cast<lpp__integer_t>(static_cast<std::uint8_t>(c)));
+            return lpp__make_value(static_cast<lpp__integer_t>(static_cast<std::uint8_t>(c)));
         }
 
     case read_mode_t::READ_MODE_LINE:
@@ -1002,7 +1002,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                 if(c == '\n'
                 || !in.f_file->f_istream)
                 {
-                    return std::make_shared<lpp__value>(line);
+                    return lpp__make_value(line);
                 }
                 line += c;
             }
@@ -1020,7 +1020,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                 // we reached the end of the file
                 // (TODO: or an error occurred)
                 //
-                return std::make_shared<lpp__value>(s);
+                return lpp__make_value(s);
             }
             s += c;
             int l(1);
@@ -1055,7 +1055,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
                     break;
                 }
             }
-            return std::make_shared<lpp__value>(s);
+            return lpp__make_value(s);
         }
 
     case read_mode_t::READ_MODE_WORD:
@@ -1064,7 +1064,7 @@ lpp__value::pointer_t lpp__read_file(lpp__context::pointer_t context, std::strin
             std::string const word(in.get_word());
             if(word != "\n")
             {
-                return std::make_shared<lpp__value>(word);
+                return lpp__make_value(word);
             }
         }
 
@@ -1237,7 +1237,7 @@ void lpp__close_file(lpp__context::pointer_t context, std::string const & filena
             }
             std::string const buffer(ss->str());
             context->set_thing(it->second->f_filename
-                             , std::make_shared<lpp__value>(buffer));
+                             , lpp__make_value(buffer));
         }
 
         g_files.erase(it);
@@ -0,0 +1,260 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// self
+//
+#include "lpp.hpp"
+
+// C++ lib
+//
+#include <algorithm>
+
+
+
+namespace lpp
+{
+
+
+/** \brief A list is a window over a buffer of items.
+ *
+ * Lists are never modified once created. Instead, all the lists derived
+ * from one another (with FPUT, LPUT, BUTFIRST, BUTLAST) share the same
+ * buffer and only differ by the window (f_begin/f_end) they see in it.
+ *
+ * The buffer keeps free slots on both sides. The first list to add an
+ * item right before (FPUT) or right after (LPUT) the slots used so far
+ * claims that slot and no copy occurs. Another list adding an item at
+ * the same place has to make a copy. The buffer never gets reallocated,
+ * so iterators and references to items stay valid as long as the list
+ * exists.
+ *
+ * This makes the classic recursion over `butfirst :list` linear instead
+ * of quadratic.
+ */
+lpp__list::lpp__list()
+{
+}
+
+
+void * lpp__list::buffer_t::operator new (std::size_t size)
+{
+    static_cast<void>(size);
+    return lpp__pool<sizeof(buffer_t)>::allocate();
+}
+
+
+void lpp__list::buffer_t::operator delete (void * ptr)
+{
+    lpp__pool<sizeof(buffer_t)>::release(ptr);
+}
+
+
+void intrusive_ptr_add_ref(lpp__list::buffer_t * buffer)
+{
+    ++buffer->f_refcount;
+}
+
+
+void intrusive_ptr_release(lpp__list::buffer_t * buffer)
+{
+    --buffer->f_refcount;
+    if(buffer->f_refcount == 0)
+    {
+        delete buffer;
+    }
+}
+
+
+lpp__list::lpp__list(vector_t const & items)
+    : f_begin(0)
+    , f_end(items.size())
+{
+    // the empty list (i.e. the :REST of most calls) needs no buffer
+    //
+    if(!items.empty())
+    {
+        f_buffer = new buffer_t;
+        f_buffer->f_items = items;
+        f_buffer->f_first = 0;
+        f_buffer->f_last = items.size();
+    }
+}
+
+
+lpp__list::lpp__list(buffer_pointer_t buffer, std::size_t begin, std::size_t end)
+    : f_buffer(buffer)
+    , f_begin(begin)
+    , f_end(end)
+{
+}
+
+
+bool lpp__list::empty() const
+{
+    return f_begin == f_end;
+}
+
+
+std::size_t lpp__list::size() const
+{
+    return f_end - f_begin;
+}
+
+
+lpp__list::value_pointer_t const & lpp__list::operator [] (std::size_t idx) const
+{
+    return f_buffer->f_items[f_begin + idx];
+}
+
+
+lpp__list::value_pointer_t const & lpp__list::front() const
+{
+    return f_buffer->f_items[f_begin];
+}
+
+
+lpp__list::value_pointer_t const & lpp__list::back() const
+{
+    return f_buffer->f_items[f_end - 1];
+}
+
+
+lpp__list::const_iterator lpp__list::begin() const
+{
+    if(f_buffer == nullptr)
+    {
+        return nullptr;
+    }
+    return f_buffer->f_items.data() + f_begin;
+}
+
+
+lpp__list::const_iterator lpp__list::end() const
+{
+    if(f_buffer == nullptr)
+    {
+        return nullptr;
+    }
+    return f_buffer->f_items.data() + f_end;
+}
+
+
+lpp__list::vector_t lpp__list::to_vector() const
+{
+    return vector_t(begin(), end());
+}
+
+
+/** \brief Create a new list with \p item inserted at the front.
+ *
+ * \param[in] item  The item to add.
+ *
+ * \return The new list.
+ */
+lpp__list lpp__list::fput(value_pointer_t item) const
+{
+    if(f_buffer != nullptr
+    && f_begin == f_buffer->f_first
+    && f_begin > 0)
+    {
+        --f_buffer->f_first;
+        f_buffer->f_items[f_buffer->f_first] = item;
+        return lpp__list(f_buffer, f_begin - 1, f_end);
+    }
+
+    // no room in front, make a new buffer with as many free slots in
+    // front as there are items so a sequence of FPUT is amortized O(1)
+    //
+    std::size_t const count(size());
+    std::size_t const room(std::max(count, static_cast<std::size_t>(4)));
+
+    buffer_pointer_t buffer(new buffer_t);
+    buffer->f_items.resize(room + count);
+    std::copy(begin(), end(), buffer->f_items.begin() + room);
+    buffer->f_first = room - 1;
+    buffer->f_last = room + count;
+    buffer->f_items[room - 1] = item;
+
+    return lpp__list(buffer, room - 1, room + count);
+}
+
+
+/** \brief Create a new list with \p item appended at the end.
+ *
+ * \param[in] item  The item to add.
+ *
+ * \return The new list.
+ */
+lpp__list lpp__list::lput(value_pointer_t item) const
+{
+    if(f_buffer != nullptr
+    && f_end == f_buffer->f_last
+    && f_end < f_buffer->f_items.size())
+    {
+        f_buffer->f_items[f_buffer->f_last] = item;
+        ++f_buffer->f_last;
+        return lpp__list(f_buffer, f_begin, f_end + 1);
+    }
+
+    std::size_t const count(size());
+    std::size_t const room(std::max(count, static_cast<std::size_t>(4)));
+
+    buffer_pointer_t buffer(new buffer_t);
+    buffer->f_items.resize(count + room);
+    std::copy(begin(), end(), buffer->f_items.begin());
+    buffer->f_first = 0;
+    buffer->f_last = count + 1;
+    buffer->f_items[count] = item;
+
+    return lpp__list(buffer, 0, count + 1);
+}
+
+
+/** \brief Create a new list without its first \p count items.
+ *
+ * The caller is expected to verify that the list has at least
+ * \p count items.
+ *
+ * \param[in] count  The number of items to remove.
+ *
+ * \return The new list.
+ */
+lpp__list lpp__list::butfirst(std::size_t count) const
+{
+    return lpp__list(f_buffer, f_begin + count, f_end);
+}
+
+
+/** \brief Create a new list without its last \p count items.
+ *
+ * The caller is expected to verify that the list has at least
+ * \p count items.
+ *
+ * \param[in] count  The number of items to remove.
+ *
+ * \return The new list.
+ */
+lpp__list lpp__list::butlast(std::size_t count) const
+{
+    return lpp__list(f_buffer, f_begin, f_end - count);
+}
+
+
+
+} // lpp namespace
+// vim: ts=4 sw=4 et nocindent
@@ -17,16 +17,22 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // boost lib
-// (C++17 will have these)
 //
-#include <boost/variant.hpp>
+#include <boost/intrusive_ptr.hpp>
 
 // C++ lib
 //
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 
 
@@ -39,8 +45,7 @@ enum class lpp__special_value_t
 };
 
 
-// WARNING: must match the variant::which() one to one
-enum class lpp__value_type_t
+enum class lpp__value_type_t : std::uint8_t
 {
     LPP__VALUE_TYPE_SPECIAL,
     LPP__VALUE_TYPE_BOOLEAN,
@@ -70,11 +75,121 @@ typedef double                  lpp__float_t;
 typedef std::vector<lpp__integer_t>     lpp__vector_integer_t;
 
 
+// names of variables, properties and procedures are interned in a global
+// table and represented by an atom (a small integer) at run time
+//
+typedef std::uint32_t                   lpp__atom_t;
+
+constexpr lpp__atom_t                   LPP__ATOM_NONE = 0;
+
+lpp__atom_t                             lpp__intern(std::string const & name);
+lpp__atom_t                             lpp__find_atom(std::string const & name);
+std::string const &                     lpp__atom_name(lpp__atom_t atom);
+
+
+// small objects (values, words, lists) are created and destroyed all
+// the time, even in the simplest loop; instead of going back to the
+// allocator, the released objects are kept in a free list per size
+// and reused so a long running loop does not grow or fragment memory
+//
+void *                      lpp__pool_grow(void * & free_list, std::size_t size);
+
+template<std::size_t SIZE>
+class lpp__pool
+{
+public:
+    static_assert(SIZE >= sizeof(void *), "lpp__pool objects must be able to hold a pointer.");
+
+    static void * allocate()
+    {
+        if(f_free_list == nullptr)
+        {
+            return lpp__pool_grow(f_free_list, SIZE);
+        }
+        void * ptr(f_free_list);
+        f_free_list = *static_cast<void **>(ptr);
+        return ptr;
+    }
+
+    static void release(void * ptr)
+    {
+        *static_cast<void **>(ptr) = f_free_list;
+        f_free_list = ptr;
+    }
+
+private:
+    static void *           f_free_list;
+};
+
+template<std::size_t SIZE>
+void * lpp__pool<SIZE>::f_free_list = nullptr;
+
+
+class lpp__value;
+
+
+// a persistent list: copies share the same items so FPUT, LPUT,
+// BUTFIRST and BUTLAST do not have to duplicate the whole list
+//
+class lpp__list
+{
+public:
+    typedef boost::intrusive_ptr<lpp__value>    value_pointer_t;
+    typedef std::vector<value_pointer_t>        vector_t;
+    typedef value_pointer_t const *             const_iterator;
+
+                            lpp__list();
+    explicit                lpp__list(vector_t const & items);
+
+    bool                    empty() const;
+    std::size_t             size() const;
+    value_pointer_t const & operator [] (std::size_t idx) const;
+    value_pointer_t const & front() const;
+    value_pointer_t const & back() const;
+    const_iterator          begin() const;
+    const_iterator          end() const;
+    vector_t                to_vector() const;
+
+    lpp__list               fput(value_pointer_t item) const;
+    lpp__list               lput(value_pointer_t item) const;
+    lpp__list               butfirst(std::size_t count = 1) const;
+    lpp__list               butlast(std::size_t count = 1) const;
+
+private:
+    struct buffer_t
+    {
+        static void *           operator new (std::size_t size);
+        static void             operator delete (void * ptr);
+
+        vector_t                f_items = vector_t();
+        std::size_t             f_first = 0;    // first slot used by any list
+        std::size_t             f_last = 0;     // one past the last slot used by any list
+        std::uint32_t           f_refcount = 0;
+    };
+
+    typedef boost::intrusive_ptr<buffer_t>      buffer_pointer_t;
+
+    friend void             intrusive_ptr_add_ref(buffer_t * buffer);
+    friend void             intrusive_ptr_release(buffer_t * buffer);
+
+                            lpp__list(buffer_pointer_t buffer, std::size_t begin, std::size_t end);
+
+    buffer_pointer_t        f_buffer = buffer_pointer_t();
+    std::size_t             f_begin = 0;
+    std::size_t             f_end = 0;
+};
+
+
+// a value is 16 bytes but it is not an immediate yet (see TODO.txt):
+// lists, things and return values hold an 8 byte pointer to a value
+// allocated from the 16 byte pool, so a list item costs 24 bytes
+//
 class lpp__value
 {
 public:
-    typedef std::shared_ptr<lpp__value>         pointer_t;
+    typedef boost::intrusive_ptr<lpp__value>    pointer_t;
     typedef std::vector<pointer_t>              vector_t;
+    typedef lpp__list                           list_t;
     typedef std::map<std::string, pointer_t>    map_t;
 
                             lpp__value(lpp__special_value_t value = lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET);
@@ -83,10 +198,20 @@ public:
                             lpp__value(lpp__float_t value);
                             lpp__value(std::string const & value);
                             lpp__value(vector_t const & value);
+                            lpp__value(list_t const & value);
                             lpp__value(map_t const & value);
+                            lpp__value(lpp__value const & rhs);
+                            ~lpp__value();
+
+    lpp__value &            operator = (lpp__value const & rhs);
+
+    static void *           operator new (std::size_t size);
+    static void             operator delete (void * ptr);
 
     lpp__value_type_t       type() const;
     bool                    is_set() const;
+    void                    set_constant();
+    bool                    is_constant() const;
     bool                    represents_word() const;
     bool                    represents_integer() const;
     bool                    represents_float() const;
@@ -95,7 +220,7 @@ public:
     lpp__integer_t          get_integer() const;
     lpp__float_t            get_float() const;
     std::string const &     get_word() const;
-    vector_t const &        get_list() const;
+    list_t const &          get_list() const;
     map_t const &           get_prop() const;
 
     void                    unset();
@@ -104,6 +229,7 @@ public:
     void                    set_float(lpp__float_t value);
     void                    set_word(std::string const & value);
     void                    set_list(vector_t const & value);
+    void                    set_list(list_t const & value);
     void                    set_prop(map_t const & value);
 
     std::string             to_string(display_flag_t flags = 0, int depth = 0) const;
@@ -115,19 +241,89 @@ public:
                                    , lpp__value::pointer_t value);
 
 private:
-    // WARNING: the order of the types is captured in the lpp__value_type_t
-    //          and it must match one to one
+    // words, lists and property lists are allocated once and shared
+    // between copies of the value; they are never modified once created
+    //
+    template<typename T>
+    struct shared_t
+    {
+                                shared_t(T const & data) : f_data(data) {}
+
+        static void *           operator new (std::size_t size) { static_cast<void>(size); return lpp__pool<sizeof(shared_t)>::allocate(); }
+        static void             operator delete (void * ptr) { lpp__pool<sizeof(shared_t)>::release(ptr); }
+
+        std::uint32_t           f_refcount = 1;
+        T const                 f_data;
+    };
+
+    union payload_t
+    {
+        lpp__special_value_t    f_special;
+        bool                    f_boolean;
+        lpp__integer_t          f_integer;
+        lpp__float_t            f_float;
+        shared_t<std::string> * f_word;
+        shared_t<list_t> *      f_list;
+        shared_t<map_t> *       f_prop;
+    };
+
+    friend void             intrusive_ptr_add_ref(lpp__value const * value);
+    friend void             intrusive_ptr_release(lpp__value const * value);
+
+    void                    check_type(lpp__value_type_t type) const;
+    void                    check_writable() const;
+    void                    acquire_payload();
+    void                    release_payload();
+
+    // the whole value fits in 16 bytes: the type, the constant flag and
+    // the reference counter of the value share the first 8 bytes, the
+    // immediate value or the pointer to the shared data uses the other 8
     //
-    boost::variant<lpp__special_value_t
-                 , bool
-                 , lpp__integer_t
-                 , double
-                 , std::string
-                 , vector_t
-                 , map_t>
-                            f_value = lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET;
+    lpp__value_type_t       f_type = lpp__value_type_t::LPP__VALUE_TYPE_SPECIAL;
+    bool                    f_constant = false;
+    mutable std::uint32_t   f_refcount = 0;
+    payload_t               f_payload = payload_t();
 };
 
+static_assert(sizeof(lpp__value) == 16, "lpp__value is expected to be 16 bytes.");
+
+
+// the run time is single threaded so the counter does not need to be atomic
+//
+inline void intrusive_ptr_add_ref(lpp__value const * value)
+{
+    ++value->f_refcount;
+}
+
+
+inline void intrusive_ptr_release(lpp__value const * value)
+{
+    --value->f_refcount;
+    if(value->f_refcount == 0)
+    {
+        delete value;
+    }
+}
+
+
+template<typename ... ARGS>
+lpp__value::pointer_t lpp__make_value(ARGS && ... args)
+{
+    return lpp__value::pointer_t(new lpp__value(std::forward<ARGS>(args)...));
+}
+
+
+// the literals of the generated code are created once and shared by
+// all the executions so they cannot be modified
+//
+template<typename ... ARGS>
+lpp__value::pointer_t lpp__make_constant(ARGS && ... args)
+{
+    lpp__value::pointer_t value(new lpp__value(std::forward<ARGS>(args)...));
+    value->set_constant();
+    return value;
+}
+
 
 
 
@@ -144,8 +340,8 @@ enum class lpp__thing_type_t
 class lpp__thing
 {
 public:
-    typedef std::shared_ptr<lpp__thing>             pointer_t;
-    typedef std::map<std::string, pointer_t>        map_t;
+    typedef lpp__thing *                            pointer_t;
+    typedef std::unordered_map<lpp__atom_t, lpp__thing>     map_t;
 
     lpp__thing_type_t       get_type() const;
     void                    set_type(lpp__thing_type_t type);
@@ -218,7 +414,7 @@ class lpp__error
 {
 public:
                             lpp__error();
-                            lpp__error(std::shared_ptr<lpp__context const> context
+                            lpp__error(lpp__context const * context
                                      , lpp__error_code_t code
                                      , std::string const & tag
                                      , std::string const & message
@@ -258,7 +454,7 @@ constexpr procedure_flag_t      PROCEDURE_FLAG_PRIMITIVE = 0x00000001;  // it's
 constexpr procedure_flag_t      PROCEDURE_FLAG_PROCEDURE = 0x00000002;  // it's a user defined procedure
 constexpr procedure_flag_t      PROCEDURE_FLAG_FUNCTION  = 0x00000004;  // it returns something
 
-typedef void (*lpp__procedure_t)(std::shared_ptr<lpp__context> context);
+typedef void (*lpp__procedure_t)(lpp__context * context);
 
 struct lpp__procedure_info_t
 {
@@ -268,16 +464,49 @@ struct lpp__procedure_info_t
     std::uint32_t               f_def_args = 0;
     std::uint32_t               f_max_args = 0;
     procedure_flag_t            f_flags = 0;
+    lpp__atom_t const *         f_slot_names = nullptr;     // layout of the arguments (user procedures only)
+    std::size_t                 f_slot_count = 0;
 };
 
+/** \brief Register a table of user procedures.
+ *
+ * The generated code creates one such object with its procedures and
+ * the perfect hash used to search them by name (see perfect_hash.hpp).
+ * The objects are linked together so registering a table does not
+ * allocate anything.
+ */
 class lpp__auto_register_procedures
 {
 public:
-    lpp__auto_register_procedures(lpp__procedure_info_t const * procedures, size_t count);
+                                    lpp__auto_register_procedures(
+                                              lpp__procedure_info_t const * procedures
+                                            , std::size_t count
+                                            , std::uint32_t const * seeds
+                                            , std::uint32_t const * slots
+                                            , std::size_t size);
+                                    lpp__auto_register_procedures(lpp__auto_register_procedures const &) = delete;
+    lpp__auto_register_procedures & operator = (lpp__auto_register_procedures const &) = delete;
+
+    lpp__procedure_info_t const *   find(char const * name) const;
+    lpp__procedure_info_t const *   begin() const;
+    lpp__procedure_info_t const *   end() const;
+    lpp__auto_register_procedures const *
+                                    next() const;
+
+private:
+    lpp__procedure_info_t const *   f_procedures = nullptr;
+    std::size_t                     f_count = 0;
+    std::uint32_t const *           f_seeds = nullptr;
+    std::uint32_t const *           f_slots = nullptr;
+    std::size_t                     f_size = 0;
+    lpp__auto_register_procedures const *
+                                    f_next = nullptr;
 };
 
 
 lpp__procedure_info_t const *           find_procedure(std::string const & name);
+lpp__procedure_info_t const *           find_procedure(char const * name);
+lpp__procedure_info_t const *           find_procedure(lpp__atom_t name);
 lpp__value::vector_t                    get_procedures(procedure_flag_t flag);
 
 
@@ -304,18 +533,41 @@ enum class trace_mode_t : std::int8_t
 
 
 
+// a context represents one frame of the Logo stack
+//
+// contexts are allocated on the C++ stack by the generated code and
+// primitives receive a bare pointer to them; a context is always
+// destroyed before its parent so the parent pointer is never dangling
+//
+// the arguments of the callee are saved in slots which the compiler lays
+// out in the order of the declaration (required, optional, rest); the
+// names of those slots are found in a static table and the std::map is
+// only used for variables that get created dynamically (LOCAL, MAKE, etc.)
+//
+// the LOCAL and LOCALMAKE variables which the compiler can determine are
+// saved in a second set of slots owned by the callee (see lpp__locals);
+// such a slot is only visible once it was declared (i.e. its type is not
+// LPP__THING_TYPE_DEFAULT anymore)
+//
 class lpp__context
-    : public std::enable_shared_from_this<lpp__context>
 {
 public:
-    typedef std::shared_ptr<lpp__context>       pointer_t;
-    typedef std::weak_ptr<lpp__context>         weak_pointer_t;
-    typedef std::shared_ptr<lpp__context const> const_pointer_t;
-
-                            lpp__context(std::string const & filename, std::string const & procedure, lpp__integer_t line, bool primitive);
+    typedef lpp__context *                      pointer_t;
+    typedef lpp__context const *                const_pointer_t;
+
+                            lpp__context(char const * filename
+                                       , char const * procedure
+                                       , lpp__integer_t line
+                                       , bool primitive
+                                       , lpp__atom_t const * slot_names = nullptr
+                                       , lpp__thing * slots = nullptr
+                                       , std::size_t slot_count = 0);
+                            lpp__context(lpp__context const &) = delete;
                             ~lpp__context();
 
-    std::string const &     get_filename() const;
+    lpp__context &          operator = (lpp__context const &) = delete;
+
+    char const *            get_filename() const;
     std::string             get_procedure_name() const;
     lpp__integer_t          get_current_line() const;
     std::string             get_primitive_name() const;
@@ -323,8 +575,21 @@ public:
     void                    set_global(pointer_t global);
     pointer_t               get_global();
 
+    lpp__thing &            get_slot(std::size_t idx) { return f_slots[idx]; }
+    lpp__value::pointer_t   get_slot_value(std::size_t idx) const;
+    void                    set_slot_value(std::size_t idx, lpp__value::pointer_t value);
+    void                    set_local_slots(lpp__atom_t const * names, lpp__thing * slots, std::size_t count);
+    lpp__value::pointer_t   get_local_value(std::size_t idx) const;
+    void                    set_local_value(std::size_t idx, lpp__value::pointer_t value);
+    void                    declare_local(std::size_t idx, lpp__value::pointer_t value = lpp__value::pointer_t());
+    lpp__thing::pointer_t   find_thing(lpp__atom_t name) const;
     lpp__thing::pointer_t   find_thing(std::string const & name) const;
+    lpp__thing::pointer_t   get_thing(lpp__atom_t name) const;          // throw if not set
     lpp__thing::pointer_t   get_thing(std::string const & name) const;  // throw if not set
+    lpp__value::vector_t    get_arguments(std::initializer_list<char const *> names, bool rest = false) const;
+    void                    set_thing(lpp__atom_t name
+                                    , lpp__value::pointer_t value
+                                    , lpp__thing_type_t type = lpp__thing_type_t::LPP__THING_TYPE_DEFAULT);
     void                    set_thing(std::string const & name
                                     , lpp__value::pointer_t value
                                     , lpp__thing_type_t type = lpp__thing_type_t::LPP__THING_TYPE_DEFAULT);
@@ -353,22 +618,38 @@ public:
 
     [[noreturn]] void       end_of_function_reached();
     void                    set_trace(std::string const & name, bool trace);
+    bool                    is_traced(lpp__atom_t name) const;
     bool                    is_traced(std::string const & name) const;
     void                    trace_procedure(trace_mode_t action, lpp__value::pointer_t data);
 
     void                    set_notify(std::string const & variable_name, std::string const & procedure_name);
     void                    remove_notify(std::string const & variable_name, std::string const & procedure_name);
+    bool                    has_notifications() const;
 
     void                    attach(pointer_t parent);
+    void                    restart();
 
 private:
-    weak_pointer_t          f_global = lpp__context::pointer_t();
-    pointer_t               f_parent = lpp__context::pointer_t();
+    lpp__thing::pointer_t   find_local_thing(lpp__atom_t name, bool undeclared = false) const;
+    void                    set_local_thing(lpp__atom_t name
+                                          , lpp__value::pointer_t value
+                                          , lpp__thing_type_t type);
+    void                    trace_make(lpp__atom_t name, lpp__value::pointer_t value);
+    void                    notify(lpp__atom_t name);
+
+    pointer_t               f_global = nullptr;
+    pointer_t               f_parent = nullptr;
+    lpp__atom_t const *     f_slot_names = nullptr;
+    lpp__thing *            f_slots = nullptr;
+    std::size_t             f_slot_count = 0;
+    lpp__atom_t const *     f_local_slot_names = nullptr;
+    lpp__thing *            f_local_slots = nullptr;
+    std::size_t             f_local_slot_count = 0;
     lpp__thing::map_t       f_things = lpp__thing::map_t();
     lpp__value::pointer_t   f_return_value = lpp__value::pointer_t();
     lpp__vector_integer_t   f_repeat_count = lpp__vector_integer_t();
-    std::string             f_filename = std::string();
-    std::string             f_procedure = std::string();
+    char const *            f_filename = "";
+    char const *            f_procedure = "";
     lpp__integer_t          f_line = 0;
     bool                    f_primitive = false;
     test_t                  f_test = test_t::TEST_UNDEFINED;
@@ -376,13 +657,66 @@ private:
 };
 
 
+// a context with N argument slots, this is what the generated code
+// allocates on the stack for each call
+//
+template<std::size_t N>
+class lpp__frame
+    : public lpp__context
+{
+public:
+                            lpp__frame(lpp__atom_t const * slot_names
+                                     , char const * filename
+                                     , char const * procedure
+                                     , lpp__integer_t line
+                                     , bool primitive)
+                                : lpp__context(filename, procedure, line, primitive, slot_names, f_slot_things, N)
+                            {
+                            }
+
+private:
+    lpp__thing              f_slot_things[N] = {};
+};
+
+
+// the N local variables of a procedure, the generated code allocates
+// this object on the stack at the start of the procedure
+//
+template<std::size_t N>
+class lpp__locals
+{
+public:
+                            lpp__locals(lpp__context::pointer_t context, lpp__atom_t const * names)
+                                : f_context(context)
+                            {
+                                f_context->set_local_slots(names, f_things, N);
+                            }
+
+                            lpp__locals(lpp__locals const &) = delete;
+
+                            ~lpp__locals()
+                            {
+                                f_context->set_local_slots(nullptr, nullptr, 0);
+                            }
+
+    lpp__locals &           operator = (lpp__locals const &) = delete;
+
+private:
+    lpp__context::pointer_t f_context;
+    lpp__thing              f_things[N] = {};
+};
+
+
 
 class lpp__raii_repeat_count
 {
 public:
                             lpp__raii_repeat_count(lpp__context::pointer_t context, lpp__integer_t count);
+                            lpp__raii_repeat_count(lpp__raii_repeat_count const &) = delete;
                             ~lpp__raii_repeat_count();
 
+    lpp__raii_repeat_count & operator = (lpp__raii_repeat_count const &) = delete;
+
 private:
     lpp__context::pointer_t f_context;
 };
@@ -406,6 +740,31 @@ public:
     lpp__value::pointer_t       to_value() const;
     void                        save_as_return_value();
 
+    static lpp__value::pointer_t
+                                to_value(lpp__integer_t number);
+    static lpp__value::pointer_t
+                                to_value(lpp__float_t number);
+    static lpp__float_t         divide(
+                                          lpp__context::pointer_t context
+                                        , lpp__float_t lhs
+                                        , lpp__float_t rhs);
+    static lpp__integer_t       add(
+                                          lpp__context::pointer_t context
+                                        , lpp__integer_t lhs
+                                        , lpp__integer_t rhs);
+    static lpp__integer_t       subtract(
+                                          lpp__context::pointer_t context
+                                        , lpp__integer_t lhs
+                                        , lpp__integer_t rhs);
+    static lpp__integer_t       multiply(
+                                          lpp__context::pointer_t context
+                                        , lpp__integer_t lhs
+                                        , lpp__integer_t rhs);
+    static lpp__integer_t       negate(
+                                          lpp__context::pointer_t context
+                                        , lpp__integer_t value);
+    [[noreturn]] static void    overflow(lpp__context::pointer_t context);
+
     void                        apply_unary(
                                           std::function<lpp__integer_t(lpp__context::pointer_t context, lpp__integer_t lhs, lpp__integer_t rhs)> i
                                         , std::function<lpp__float_t(lpp__context::pointer_t context, lpp__float_t lhs, lpp__float_t rhs)> f);
@@ -451,6 +810,53 @@ private:
 };
 
 
+// the integer arithmetic of the generated code is inline; only the
+// error is not
+//
+inline lpp__integer_t lpp__number::add(lpp__context::pointer_t context, lpp__integer_t lhs, lpp__integer_t rhs)
+{
+    lpp__integer_t result(0);
+    if(__builtin_add_overflow(lhs, rhs, &result))
+    {
+        overflow(context);
+    }
+    return result;
+}
+
+
+inline lpp__integer_t lpp__number::subtract(lpp__context::pointer_t context, lpp__integer_t lhs, lpp__integer_t rhs)
+{
+    lpp__integer_t result(0);
+    if(__builtin_sub_overflow(lhs, rhs, &result))
+    {
+        overflow(context);
+    }
+    return result;
+}
+
+
+inline lpp__integer_t lpp__number::multiply(lpp__context::pointer_t context, lpp__integer_t lhs, lpp__integer_t rhs)
+{
+    lpp__integer_t result(0);
+    if(__builtin_mul_overflow(lhs, rhs, &result))
+    {
+        overflow(context);
+    }
+    return result;
+}
+
+
+inline lpp__integer_t lpp__number::negate(lpp__context::pointer_t context, lpp__integer_t value)
+{
+    lpp__integer_t result(0);
+    if(__builtin_sub_overflow(static_cast<lpp__integer_t>(0), value, &result))
+    {
+        overflow(context);
+    }
+    return result;
+}
+
+
 
 
 
@@ -720,6 +1126,31 @@ void primitive_writer(lpp::lpp__context::pointer_t context);
 // X
 void primitive_xor(lpp::lpp__context::pointer_t context);
 
+// primitives marked PRIMITIVE_ARGUMENTS in primitives.def; the generated
+// code calls them with all their arguments in an array (rest included)
+// and they return their result
+//
+lpp::lpp__value::pointer_t primitive_butfirst(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_butlast(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_count(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_emptyp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_first(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_fput(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_item(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_last(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_list(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_listp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_lput(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_memberp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_not(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_numberp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_print(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_sentence(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_show(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_type(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_word(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+lpp::lpp__value::pointer_t primitive_wordp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc);
+
 
 // helpers
 //
@@ -34,15 +34,14 @@ int main(int argc, char * argv[])
 {
     try
     {
-        lpp::lpp__auto_register_procedures primitives(nullptr, 0);  // register primitives
-
-        lpp::lpp__context::pointer_t context(std::make_shared<lpp::lpp__context>(std::string(), "program", 0, false));
+        lpp::lpp__context global("", "program", 0, false);
+        lpp::lpp__context::pointer_t context(&global);
         context->set_global(context);
 
         lpp::lpp__value::vector_t argument_list;
         for(int i(0); i < argc; ++i)
         {
-            lpp::lpp__value::pointer_t arg(std::make_shared<lpp::lpp__value>(std::string(argv[i])));
+            lpp::lpp__value::pointer_t arg(lpp::lpp__make_value(std::string(argv[i])));
             if(arg->represents_integer())
             {
                 arg->set_integer(arg->to_integer());
@@ -53,7 +52,7 @@ int main(int argc, char * argv[])
             }
             argument_list.push_back(arg);
         }
-        lpp::lpp__value::pointer_t arguments(std::make_shared<lpp::lpp__value>(argument_list));
+        lpp::lpp__value::pointer_t arguments(lpp::lpp__make_value(argument_list));
 
         context->set_thing("arguments", arguments, lpp::lpp__thing_type_t::LPP__THING_TYPE_GLOBAL);
 
@@ -125,20 +125,85 @@ lpp__value::pointer_t lpp__number::to_value() const
 {
     if(f_is_integer)
     {
-        return std::make_shared<lpp__value>(f_integer);
+        return to_value(f_integer);
     }
     else
     {
-        lpp__value::pointer_t flt(std::make_shared<lpp__value>(f_float));
-        if(flt->represents_integer())
-        {
-            flt->set_integer(static_cast<lpp__integer_t>(f_float));
-        }
-        return flt;
+        return to_value(f_float);
     }
 }
 
 
+/** \brief Save a number computed natively in a value.
+ *
+ * The compiler generates arithmetic expressions with C++ numbers when
+ * all the operands are known to be numbers. This function saves the
+ * result the same way lpp__number does.
+ *
+ * \param[in] number  The number to save in a value.
+ *
+ * \return The new value.
+ */
+lpp__value::pointer_t lpp__number::to_value(lpp__integer_t number)
+{
+    return lpp__make_value(number);
+}
+
+
+/** \brief Save a floating point number computed natively in a value.
+ *
+ * Like for the other arithmetic results, a floating point with
+ * no fraction is saved as an integer.
+ *
+ * \param[in] number  The number to save in a value.
+ *
+ * \return The new value.
+ */
+lpp__value::pointer_t lpp__number::to_value(lpp__float_t number)
+{
+    lpp__value::pointer_t flt(lpp__make_value(number));
+    if(flt->represents_integer())
+    {
+        flt->set_integer(static_cast<lpp__integer_t>(number));
+    }
+    return flt;
+}
+
+
+lpp__float_t lpp__number::divide(lpp__context::pointer_t context, lpp__float_t lhs, lpp__float_t rhs)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+    if(rhs == 0.0)
+    {
+        throw lpp__error(context
+                       , lpp__error_code_t::ERROR_CODE_ARITHMETIC_ERROR
+                       , "error"
+                       , "divisor cannot be zero.");
+    }
+#pragma GCC diagnostic pop
+
+    return lhs / rhs;
+}
+
+
+/** \brief Report an integer overflow.
+ *
+ * The inline integer arithmetic of the generated code (add(), subtract(),
+ * multiply() and negate()) calls this function when the result does not
+ * fit in an lpp__integer_t.
+ *
+ * \param[in] context  The context where the error occurred.
+ */
+void lpp__number::overflow(lpp__context::pointer_t context)
+{
+    throw lpp__error(context
+                   , lpp__error_code_t::ERROR_CODE_ARITHMETIC_ERROR
+                   , "error"
+                   , "integer overflow.");
+}
+
+
 void lpp__number::save_as_return_value()
 {
     f_context->set_return_value(to_value());
@@ -266,7 +331,7 @@ void lpp__number::compute(
             }
             else
             {
-                lpp__value::vector_t const & items(rest->get_list());
+                lpp__value::list_t const & items(rest->get_list());
                 if(items.size() != 1)
                 {
                     throw lpp__error(context
@@ -284,7 +349,7 @@ void lpp__number::compute(
             lpp__thing::pointer_t rest(context->find_thing(rest_name));
             if(rest != nullptr)
             {
-                lpp__value::vector_t const & items(rest->get_value()->get_list());
+                lpp__value::list_t const & items(rest->get_value()->get_list());
                 for(auto const & r : items)
                 {
                     result.apply_binary(r, i, f);
@@ -356,8 +421,8 @@ lpp__integer_t lpp__number::compare_values(
         if(lhs->type() == lpp__value_type_t::LPP__VALUE_TYPE_LIST
         && rhs->type() == lpp__value_type_t::LPP__VALUE_TYPE_LIST)
         {
-            lpp__value::vector_t ll(lhs->get_list());
-            lpp__value::vector_t lr(rhs->get_list());
+            lpp__value::list_t const & ll(lhs->get_list());
+            lpp__value::list_t const & lr(rhs->get_list());
             size_t const max(std::min(ll.size(), lr.size()));
             for(size_t idx(0); idx < max; ++idx)
             {
@@ -408,7 +473,7 @@ void lpp__number::compare(
         lpp__thing::pointer_t rest(context->find_thing(rest_name));
         if(rest != nullptr)
         {
-            lpp__value::vector_t const & items(rest->get_value()->get_list());
+            lpp__value::list_t const & items(rest->get_value()->get_list());
             for(auto const & it : items)
             {
                 c = compare_values(context, lhs, it, characters);
@@ -421,7 +486,7 @@ void lpp__number::compare(
         }
     }
 
-    lpp__value::pointer_t result(std::make_shared<lpp__value>(boolean));
+    lpp__value::pointer_t result(lpp__make_value(boolean));
     context->set_return_value(result);
 }
 
@@ -455,7 +520,7 @@ void lpp__number::logical(
         lpp__thing::pointer_t rest(context->find_thing(rest_name));
         if(rest != nullptr)
         {
-            lpp__value::vector_t const & items(rest->get_value()->get_list());
+            lpp__value::list_t const & items(rest->get_value()->get_list());
             for(auto const & it : items)
             {
                 if(it->type() != lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)
@@ -470,7 +535,7 @@ void lpp__number::logical(
         }
     }
 
-    lpp__value::pointer_t result(std::make_shared<lpp__value>(boolean));
+    lpp__value::pointer_t result(lpp__make_value(boolean));
     context->set_return_value(result);
 }
 
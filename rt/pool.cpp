@@ -0,0 +1,77 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// self
+//
+#include "lpp.hpp"
+
+
+
+namespace lpp
+{
+
+
+namespace
+{
+
+
+
+constexpr std::size_t   OBJECTS_PER_BLOCK = 1024;
+
+
+
+} // no name namespace
+
+
+
+/** \brief Allocate a new block of objects for an lpp__pool.
+ *
+ * The block is cut in OBJECTS_PER_BLOCK objects of \p size bytes. The
+ * first one is returned and the others are added to \p free_list.
+ *
+ * The blocks are never freed. Objects may still be released by the
+ * static destructors (i.e. global variables) so the memory has to
+ * stay valid until the process exits.
+ *
+ * \param[in,out] free_list  The free list of the pool to grow.
+ * \param[in] size  The size of one object.
+ *
+ * \return A pointer to a new object.
+ */
+void * lpp__pool_grow(void * & free_list, std::size_t size)
+{
+    // keep objects aligned as malloc() would
+    //
+    std::size_t const align(alignof(std::max_align_t));
+    size = (size + align - 1) & ~(align - 1);
+
+    char * block(static_cast<char *>(::operator new(size * OBJECTS_PER_BLOCK)));
+    for(std::size_t idx(1); idx < OBJECTS_PER_BLOCK; ++idx)
+    {
+        void * ptr(block + idx * size);
+        *static_cast<void **>(ptr) = free_list;
+        free_list = ptr;
+    }
+
+    return block;
+}
+
+
+
+} // lpp namespace
+// vim: ts=4 sw=4 et nocindent
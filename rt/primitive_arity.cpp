@@ -56,11 +56,11 @@ void primitive_arity(lpp::lpp__context::pointer_t context)
                             + " is not defined.");
     }
     lpp::lpp__value::vector_t list;
-    list.push_back(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(proc->f_min_args)));
-    list.push_back(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(proc->f_def_args)));
-    list.push_back(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(proc->f_max_args)));
-    list.push_back(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(proc->f_flags)));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    list.push_back(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(proc->f_min_args)));
+    list.push_back(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(proc->f_def_args)));
+    list.push_back(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(proc->f_max_args)));
+    list.push_back(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(proc->f_flags)));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
     context->set_return_value(result);
 }
 
@@ -66,7 +66,7 @@ void primitive_backslashedp(lpp::lpp__context::pointer_t context)
 
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(boolean));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(boolean));
 
     context->set_return_value(result);
 }
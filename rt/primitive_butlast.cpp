@@ -27,11 +27,13 @@
 
 
 
-void primitive_butlast(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_butlast(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>());
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value());
 
     switch(thing->type())
     {
@@ -72,7 +74,7 @@ void primitive_butlast(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t l(thing->get_list());
+            lpp::lpp__value::list_t const & l(thing->get_list());
             if(l.empty())
             {
                 throw lpp::lpp__error(context
@@ -80,8 +82,7 @@ void primitive_butlast(lpp::lpp__context::pointer_t context)
                                     , "error"
                                     , "butlast cannot be used against an empty list.");
             }
-            l.erase(l.end() - 1);
-            result->set_list(l);
+            result->set_list(l.butlast());
         }
         break;
 
@@ -93,7 +94,14 @@ void primitive_butlast(lpp::lpp__context::pointer_t context)
 
     }
 
-    context->set_return_value(result);
+    return result;
+}
+
+
+void primitive_butlast(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_butlast(context, args.data(), args.size()));
 }
 
 
@@ -31,7 +31,7 @@ void primitive_bye(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::pointer_t thing(context->get_thing("code")->get_value());
     lpp::lpp__integer_t code(static_cast<lpp::lpp__integer_t>(thing->to_float()));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(code));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(code));
     context->get_global()->set_return_value(result);
 }
 
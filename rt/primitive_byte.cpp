@@ -40,7 +40,7 @@ void primitive_byte(lpp::lpp__context::pointer_t context)
                             , "\"byte\" cannot be used against an empty word.");
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(static_cast<std::uint8_t>(word[0]))));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(static_cast<std::uint8_t>(word[0]))));
 
     context->set_return_value(result);
 }
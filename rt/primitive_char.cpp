@@ -52,7 +52,7 @@ void primitive_char(lpp::lpp__context::pointer_t context)
     }
     std::string word(lpp::wctombs(static_cast<char32_t>(n)));
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word));
 
     context->set_return_value(result);
 }
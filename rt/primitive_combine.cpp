@@ -44,7 +44,7 @@ void primitive_combine(lpp::lpp__context::pointer_t context)
         case lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD:
             {
                 std::string const word(thing1->to_word() + thing2->to_word());
-                context->set_return_value(std::make_shared<lpp::lpp__value>(word));
+                context->set_return_value(lpp::lpp__make_value(word));
             }
             break;
 
@@ -59,9 +59,7 @@ void primitive_combine(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t list(thing2->get_list());
-            list.insert(list.begin(), thing1);
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(thing2->get_list().fput(thing1)));
             context->set_return_value(result);
         }
         break;
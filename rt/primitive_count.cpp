@@ -27,9 +27,11 @@
 
 
 
-void primitive_count(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_count(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
 
     lpp::lpp__integer_t count(0);
     switch(thing->type())
@@ -64,7 +66,7 @@ void primitive_count(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t const & l(thing->get_list());
+            lpp::lpp__value::list_t const & l(thing->get_list());
             count = l.size();
         }
         break;
@@ -77,8 +79,15 @@ void primitive_count(lpp::lpp__context::pointer_t context)
 
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(count));
-    context->set_return_value(result);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(count));
+    return result;
+}
+
+
+void primitive_count(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_count(context, args.data(), args.size()));
 }
 
 
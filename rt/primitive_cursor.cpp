@@ -42,10 +42,10 @@ void primitive_cursor(lpp::lpp__context::pointer_t context)
     }
 
     lpp::lpp__value::vector_t coordinates;
-    coordinates.push_back(std::make_shared<lpp::lpp__value>(x));
-    coordinates.push_back(std::make_shared<lpp::lpp__value>(y));
+    coordinates.push_back(lpp::lpp__make_value(x));
+    coordinates.push_back(lpp::lpp__make_value(y));
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(coordinates));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(coordinates));
     context->set_return_value(result);
 }
 
@@ -46,7 +46,7 @@ void primitive_definedp(lpp::lpp__context::pointer_t context)
                             , "the :NAME argument is not expected to be empty.");
     }
     lpp::lpp__procedure_info_t const * proc(lpp::find_procedure(name));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(
                    proc != nullptr
                 && (proc->f_flags & lpp::PROCEDURE_FLAG_PROCEDURE) != 0));
     context->set_return_value(result);
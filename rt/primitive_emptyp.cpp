@@ -27,16 +27,26 @@
 
 
 
-void primitive_emptyp(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_emptyp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(
+    static_cast<void>(context);
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(
                (thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD
                 && thing->get_word().empty())
             || (thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST
                 && thing->get_list().empty())
         ));
-    context->set_return_value(result);
+    return result;
+}
+
+
+void primitive_emptyp(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_emptyp(context, args.data(), args.size()));
 }
 
 
@@ -40,7 +40,7 @@ void primitive_erase(lpp::lpp__context::pointer_t context)
                             , "the :NAMES argument is expected to be a list.");
     }
 
-    lpp::lpp__value::vector_t list(names->get_list());
+    lpp::lpp__value::list_t const & list(names->get_list());
     for(auto & it : list)
     {
         std::string const item_name(it->to_word());
@@ -31,7 +31,7 @@
 void primitive_error(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::vector_t list;
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
 
     lpp::lpp__error const & e(context->get_error());
 
@@ -46,39 +46,39 @@ void primitive_error(lpp::lpp__context::pointer_t context)
         //   the instruction line on which the error occurred.
         //
         result->add_prop("code"
-                       , std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(e.code())));
+                       , lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(e.code())));
 
         result->add_prop("tag"
-                       , std::make_shared<lpp::lpp__value>(e.tag()));
+                       , lpp::lpp__make_value(e.tag()));
 
         result->add_prop("timestamp"
-                       , std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(e.timestamp())));
+                       , lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(e.timestamp())));
 
         result->add_prop("message"
-                       , std::make_shared<lpp::lpp__value>(std::string(e.what())));
+                       , lpp::lpp__make_value(std::string(e.what())));
 
         if(!e.filename().empty())
         {
             result->add_prop("filename"
-                           , std::make_shared<lpp::lpp__value>(e.filename()));
+                           , lpp::lpp__make_value(e.filename()));
         }
 
         if(!e.procedure().empty())
         {
             result->add_prop("procedure"
-                           , std::make_shared<lpp::lpp__value>(e.procedure()));
+                           , lpp::lpp__make_value(e.procedure()));
         }
 
         if(e.line() != 0)
         {
             result->add_prop("line"
-                          , std::make_shared<lpp::lpp__value>(e.line()));
+                          , lpp::lpp__make_value(e.line()));
         }
 
         if(!e.primitive().empty())
         {
             result->add_prop("primitive"
-                          , std::make_shared<lpp::lpp__value>(e.primitive()));
+                          , lpp::lpp__make_value(e.primitive()));
         }
 
         if(e.value() != nullptr)
@@ -90,7 +90,7 @@ void primitive_error(lpp::lpp__context::pointer_t context)
         if(e.caught())
         {
             result->add_prop("caught"
-                          , std::make_shared<lpp::lpp__value>(true));
+                          , lpp::lpp__make_value(true));
         }
     }
 
@@ -31,7 +31,7 @@
 void primitive_errorp(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__error const & e(context->get_error());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(!e.tag().empty()));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(!e.tag().empty()));
     context->set_return_value(result);
 }
 
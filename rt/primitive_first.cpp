@@ -28,11 +28,13 @@
 
 
 
-void primitive_first(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_first(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>());
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value());
 
     switch(thing->type())
     {
@@ -79,7 +81,7 @@ void primitive_first(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t const & l(thing->get_list());
+            lpp::lpp__value::list_t const & l(thing->get_list());
             if(l.empty())
             {
                 throw lpp::lpp__error(context
@@ -99,7 +101,14 @@ void primitive_first(lpp::lpp__context::pointer_t context)
 
     }
 
-    context->set_return_value(result);
+    return result;
+}
+
+
+void primitive_first(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_first(context, args.data(), args.size()));
 }
 
 
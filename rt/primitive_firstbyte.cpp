@@ -31,7 +31,7 @@ void primitive_firstbyte(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::pointer_t word(context->get_thing("word")->get_value());
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>());
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value());
 
     switch(word->type())
     {
@@ -41,7 +41,7 @@ lpp::lpp__integer_t g_counter = 0;
 void primitive_gensym(lpp::lpp__context::pointer_t context)
 {
     ++g_counter;
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>("G" + std::to_string(g_counter)));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value("G" + std::to_string(g_counter)));
     context->set_return_value(result);
 }
 
@@ -39,7 +39,7 @@ void primitive_int(lpp::lpp__context::pointer_t context)
     else
     {
         lpp::lpp__integer_t i(static_cast<lpp::lpp__integer_t>(std::floor(n.get_float())));
-        lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(i));
+        lpp::lpp__value::pointer_t result(lpp::lpp__make_value(i));
         context->set_return_value(result);
     }
 }
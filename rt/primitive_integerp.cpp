@@ -30,7 +30,7 @@
 void primitive_integerp(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER));
     context->set_return_value(result);
 }
 
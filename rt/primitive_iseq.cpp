@@ -56,7 +56,7 @@ void primitive_iseq(lpp::lpp__context::pointer_t context)
         {
             for(++s; s < e; ++s)
             {
-                lpp::lpp__value::pointer_t value(std::make_shared<lpp::lpp__value>(s));
+                lpp::lpp__value::pointer_t value(lpp::lpp__make_value(s));
                 list.push_back(value);
             }
         }
@@ -64,7 +64,7 @@ void primitive_iseq(lpp::lpp__context::pointer_t context)
         {
             for(--s; s > e; --s)
             {
-                lpp::lpp__value::pointer_t value(std::make_shared<lpp::lpp__value>(s));
+                lpp::lpp__value::pointer_t value(lpp::lpp__make_value(s));
                 list.push_back(value);
             }
         }
@@ -74,7 +74,7 @@ void primitive_iseq(lpp::lpp__context::pointer_t context)
         list.push_back(number2);
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
 
     context->set_return_value(result);
 }
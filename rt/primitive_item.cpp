@@ -27,10 +27,12 @@
 
 
 
-void primitive_item(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_item(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t number(context->get_thing("number")->get_value());
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & number(args[0]);
+    lpp::lpp__value::pointer_t const & thing(args[1]);
 
     if(!number->represents_float())
     {
@@ -50,7 +52,7 @@ void primitive_item(lpp::lpp__context::pointer_t context)
     }
     --position;     // C++ position start at 0
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>());
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value());
 
     switch(thing->type())
     {
@@ -73,7 +75,7 @@ void primitive_item(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t const & l(thing->get_list());
+            lpp::lpp__value::list_t const & l(thing->get_list());
             if(static_cast<size_t>(position) >= l.size())
             {
                 throw lpp::lpp__error(context
@@ -93,7 +95,14 @@ void primitive_item(lpp::lpp__context::pointer_t context)
 
     }
 
-    context->set_return_value(result);
+    return result;
+}
+
+
+void primitive_item(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"number", "thing"}));
+    context->set_return_value(primitive_item(context, args.data(), args.size()));
 }
 
 
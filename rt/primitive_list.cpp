@@ -27,29 +27,21 @@
 
 
 
+lpp::lpp__value::pointer_t primitive_list(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
+{
+    static_cast<void>(context);
+
+    lpp::lpp__value::vector_t list(args, args + argc);
+
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
+    return result;
+}
+
+
 void primitive_list(lpp::lpp__context::pointer_t context)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-
-    lpp::lpp__value::vector_t list;
-    list.push_back(thing);
-
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
-    {
-        lpp::lpp__value::pointer_t r(rest->get_value());
-        if(r->type() != lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
-        {
-            throw lpp::lpp__error(context
-                                , lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM
-                                , "logic"
-                                , "the :REST argument is expected to always be a list.");
-        }
-        list.insert(list.end(), r->get_list().begin(), r->get_list().end());
-    }
-
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
-    context->set_return_value(result);
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}, true));
+    context->set_return_value(primitive_list(context, args.data(), args.size()));
 }
 
 
@@ -27,11 +27,21 @@
 
 
 
+lpp::lpp__value::pointer_t primitive_listp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
+{
+    static_cast<void>(context);
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST));
+    return result;
+}
+
+
 void primitive_listp(lpp::lpp__context::pointer_t context)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST));
-    context->set_return_value(result);
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_listp(context, args.data(), args.size()));
 }
 
 
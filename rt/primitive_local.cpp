@@ -29,7 +29,7 @@ namespace
 {
 
 
-void create_local(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t name)
+void create_local(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const & name)
 {
     if(!name->represents_word())
     {
@@ -38,7 +38,6 @@ void create_local(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer
                             , "error"
                             , "\"local\" expect the variable name to be a word.");
     }
-std::cerr << "<<SETTING UP \"" << name->to_word() << "\" AS LOCAL>>\n";
 
     context->set_thing(name->to_word()
                      , lpp::lpp__value::pointer_t()    // not set (i.e. value is nullptr)
@@ -64,8 +63,8 @@ void primitive_local(lpp::lpp__context::pointer_t context)
                                 , "\"local\" cannot be used with a rest when used with a list.");
         }
 
-        lpp::lpp__value::vector_t list(name->get_list());
-        for(auto item : list)
+        lpp::lpp__value::list_t const & list(name->get_list());
+        for(auto const & item : list)
         {
             create_local(context, item);
         }
@@ -77,8 +76,8 @@ void primitive_local(lpp::lpp__context::pointer_t context)
         lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
         if(rest != nullptr)
         {
-            lpp::lpp__value::vector_t list(rest->get_value()->get_list());
-            for(auto item : list)
+            lpp::lpp__value::list_t const & list(rest->get_value()->get_list());
+            for(auto const & item : list)
             {
                 create_local(context, item);
             }
@@ -27,21 +27,20 @@
 
 
 
-void primitive_lput(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_lput(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t item(context->get_thing("item")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & item(args[0]);
 
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    lpp::lpp__value::pointer_t const & thing(args[1]);
     switch(thing->type())
     {
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t list(thing->get_list());
-            list.push_back(item);
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
-            context->set_return_value(result);
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(thing->get_list().lput(item)));
+            return result;
         }
-        break;
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD:
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:
@@ -57,10 +56,9 @@ void primitive_lput(lpp::lpp__context::pointer_t context)
             }
 
             std::string const word(thing->to_word() + item->to_word());
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word));
-            context->set_return_value(result);
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word));
+            return result;
         }
-        break;
 
     default:
         throw lpp::lpp__error(context
@@ -72,4 +70,11 @@ void primitive_lput(lpp::lpp__context::pointer_t context)
 }
 
 
+void primitive_lput(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"item", "thing"}));
+    context->set_return_value(primitive_lput(context, args.data(), args.size()));
+}
+
+
 // vim: ts=4 sw=4 et nocindent
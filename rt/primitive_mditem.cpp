@@ -40,7 +40,7 @@ void primitive_mditem(lpp::lpp__context::pointer_t context)
                             , "mditem first parameter must be a list of numbers.");
     }
 
-    lpp::lpp__value::vector_t const & positions(indexes->get_list());
+    lpp::lpp__value::list_t const & positions(indexes->get_list());
     for(size_t idx(0); idx < positions.size(); ++idx)
     {
         lpp::lpp__value::pointer_t number(positions[idx]);
@@ -70,7 +70,7 @@ void primitive_mditem(lpp::lpp__context::pointer_t context)
         }
         --pos;     // C++ position start at 0
 
-        lpp::lpp__value::vector_t const & l(list->get_list());
+        lpp::lpp__value::list_t const & l(list->get_list());
         if(static_cast<size_t>(pos) >= l.size())
         {
             throw lpp::lpp__error(context
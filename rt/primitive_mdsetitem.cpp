@@ -40,10 +40,10 @@ void primitive_mdsetitem(lpp::lpp__context::pointer_t context)
                             , "\"mdsetitem\" first parameter must be a list of numbers.");
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list->get_list()));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list->get_list()));
     context->set_return_value(result);
 
-    lpp::lpp__value::vector_t const & positions(indexes->get_list());
+    lpp::lpp__value::list_t const & positions(indexes->get_list());
     for(size_t idx(0); idx < positions.size(); ++idx)
     {
         lpp::lpp__value::pointer_t number(positions[idx]);
@@ -73,7 +73,7 @@ void primitive_mdsetitem(lpp::lpp__context::pointer_t context)
         }
         --pos;     // C++ position start at 0
 
-        lpp::lpp__value::vector_t l(result->get_list());
+        lpp::lpp__value::vector_t l(result->get_list().to_vector());
         if(static_cast<size_t>(pos) >= l.size())
         {
             throw lpp::lpp__error(context
@@ -98,7 +98,7 @@ void primitive_mdsetitem(lpp::lpp__context::pointer_t context)
                                     , "\"mdsetitem\" second parameters must be a list of lists.");
             }
 
-            list = std::make_shared<lpp::lpp__value>(l[pos]->get_list());
+            list = lpp::lpp__make_value(l[pos]->get_list());
             l[pos] = list;
         }
         result->set_list(l);
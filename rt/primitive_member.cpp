@@ -52,12 +52,12 @@ void primitive_member(lpp::lpp__context::pointer_t context)
             std::string::size_type pos(word2.find(word1));
             if(pos == std::string::npos)
             {
-                lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(std::string()));
+                lpp::lpp__value::pointer_t result(lpp::lpp__make_value(std::string()));
                 context->set_return_value(result);
             }
             else
             {
-                lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word2.substr(pos)));
+                lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word2.substr(pos)));
                 context->set_return_value(result);
             }
         }
@@ -65,7 +65,7 @@ void primitive_member(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t l(thing2->get_list());
+            lpp::lpp__value::list_t const & l(thing2->get_list());
 
             auto it(std::find_if(
                       l.begin()
@@ -81,13 +81,12 @@ void primitive_member(lpp::lpp__context::pointer_t context)
                     }));
             if(it == l.end())
             {
-                lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(lpp::lpp__value::vector_t()));
+                lpp::lpp__value::pointer_t result(lpp::lpp__make_value(lpp::lpp__value::vector_t()));
                 context->set_return_value(result);
             }
             else
             {
-                lpp::lpp__value::vector_t member_list(it, l.end());
-                lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(member_list));
+                lpp::lpp__value::pointer_t result(lpp::lpp__make_value(l.butfirst(it - l.begin())));
                 context->set_return_value(result);
             }
         }
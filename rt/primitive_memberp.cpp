@@ -27,10 +27,12 @@
 
 
 
-void primitive_memberp(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_memberp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing1(context->get_thing("thing1")->get_value());
-    lpp::lpp__value::pointer_t thing2(context->get_thing("thing2")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing1(args[0]);
+    lpp::lpp__value::pointer_t const & thing2(args[1]);
 
     switch(thing2->type())
     {
@@ -50,14 +52,13 @@ void primitive_memberp(lpp::lpp__context::pointer_t context)
             std::string word1(thing1->to_word());
             std::string word2(thing2->to_word());
             std::string::size_type pos(word2.find(word1));
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(pos != std::string::npos));
-            context->set_return_value(result);
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(pos != std::string::npos));
+            return result;
         }
-        break;
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t l(thing2->get_list());
+            lpp::lpp__value::list_t const & l(thing2->get_list());
 
             auto it(std::find_if(
                       l.begin()
@@ -71,10 +72,9 @@ void primitive_memberp(lpp::lpp__context::pointer_t context)
                                                 , false));
                         return r == 0;
                     }));
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(it != l.end()));
-            context->set_return_value(result);
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(it != l.end()));
+            return result;
         }
-        break;
 
     default:
         throw lpp::lpp__error(context
@@ -86,4 +86,11 @@ void primitive_memberp(lpp::lpp__context::pointer_t context)
 }
 
 
+void primitive_memberp(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing1", "thing2"}));
+    context->set_return_value(primitive_memberp(context, args.data(), args.size()));
+}
+
+
 // vim: ts=4 sw=4 et nocindent
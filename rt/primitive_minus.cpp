@@ -32,10 +32,18 @@ namespace
 template<typename T>
 T operation(lpp::lpp__context::pointer_t , T lhs, T )
 {
-    // TODO: handle overflow/underflow
     return -lhs;
 }
 
+
+// the integers must not silently overflow
+//
+template<>
+lpp::lpp__integer_t operation(lpp::lpp__context::pointer_t context, lpp::lpp__integer_t lhs, lpp::lpp__integer_t )
+{
+    return lpp::lpp__number::negate(context, lhs);
+}
+
 } // no name namespace
 
 
@@ -22,6 +22,7 @@
 
 // C++ lib
 //
+#include <cmath>
 #include <iostream>
 
 
@@ -34,7 +35,7 @@ void primitive_nanp(lpp::lpp__context::pointer_t context)
     {
         is_nan = std::isnan(number->get_float());
     }
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(is_nan));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(is_nan));
     context->set_return_value(result);
 }
 
@@ -26,9 +26,11 @@
 
 
 
-void primitive_not(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_not(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t lhs(context->get_thing("boolean")->get_value());
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & lhs(args[0]);
     if(lhs->type() != lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)
     {
         throw lpp::lpp__error(context
@@ -37,8 +39,15 @@ void primitive_not(lpp::lpp__context::pointer_t context)
                             , "logical functions expects boolean values only.");
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(!lhs->get_boolean()));
-    context->set_return_value(result);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(!lhs->get_boolean()));
+    return result;
+}
+
+
+void primitive_not(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"boolean"}));
+    context->set_return_value(primitive_not(context, args.data(), args.size()));
 }
 
 
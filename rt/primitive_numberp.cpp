@@ -27,11 +27,21 @@
 
 
 
+lpp::lpp__value::pointer_t primitive_numberp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
+{
+    static_cast<void>(context);
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(thing->represents_float()));
+    return result;
+}
+
+
 void primitive_numberp(lpp::lpp__context::pointer_t context)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(thing->represents_float()));
-    context->set_return_value(result);
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_numberp(context, args.data(), args.size()));
 }
 
 
@@ -38,7 +38,7 @@ void primitive_openwrite(lpp::lpp__context::pointer_t context)
         // the size of the variable will be whatever the user wrote to
         // this buffer
         //
-        lpp::lpp__value::vector_t buf(filename->get_list());
+        lpp::lpp__value::list_t const & buf(filename->get_list());
         lpp::lpp__open_file(context, buf[0]->to_word(), lpp::open_mode_t::OPEN_MODE_WRITE_BUFFER);
     }
     else
@@ -62,11 +62,11 @@ void primitive_plist(lpp::lpp__context::pointer_t context)
     lpp::lpp__value::map_t const & prop(value->get_prop());
     for(auto const & p : prop)
     {
-        list.push_back(std::make_shared<lpp::lpp__value>(p.first));
+        list.push_back(lpp::lpp__make_value(p.first));
         list.push_back(p.second);
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
     context->set_return_value(result);
 }
 
@@ -40,7 +40,7 @@ void primitive_plistp(lpp::lpp__context::pointer_t context)
     }
 
     lpp::lpp__thing::pointer_t thing(context->find_property(listname->to_word()));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(
                        thing != nullptr
                     && thing->get_value() != nullptr));
     context->set_return_value(result);
@@ -60,7 +60,7 @@ void primitive_pop(lpp::lpp__context::pointer_t context)
     {
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t list(thing->get_list());
+            lpp::lpp__value::list_t const & list(thing->get_list());
             if(list.empty())
             {
                 throw lpp::lpp__error(context
@@ -70,8 +70,7 @@ void primitive_pop(lpp::lpp__context::pointer_t context)
             }
             context->set_return_value(list[0]);
 
-            list.erase(list.begin());
-            context->set_thing(name, std::make_shared<lpp::lpp__value>(list));
+            context->set_thing(name, lpp::lpp__make_value(list.butfirst()));
         }
         break;
 
@@ -90,11 +89,11 @@ void primitive_pop(lpp::lpp__context::pointer_t context)
             }
             std::string first_letter;
             first_letter += word[0];
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(first_letter));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(first_letter));
             context->set_return_value(result);
 
             word.erase(0, 1);
-            context->set_thing(name, std::make_shared<lpp::lpp__value>(word));
+            context->set_thing(name, lpp::lpp__make_value(word));
         }
         break;
 
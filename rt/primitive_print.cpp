@@ -27,22 +27,24 @@
 
 
 
-void primitive_print(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_print(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__write_file(context, std::string(), thing);
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
+    lpp::lpp__write_file(context, std::string(), args[0]);
+    for(std::size_t idx(1); idx < argc; ++idx)
     {
-        auto list(rest->get_value()->get_list());
-        size_t const max(list.size());
-        for(size_t i(0); i < max; ++i)
-        {
-            lpp::lpp__write_file(context, std::string(), " ");
-            lpp::lpp__write_file(context, std::string(), list[i]);
-        }
+        lpp::lpp__write_file(context, std::string(), " ");
+        lpp::lpp__write_file(context, std::string(), args[idx]);
     }
     lpp::lpp__write_file(context, std::string(), "\n");
+
+    return lpp::lpp__value::pointer_t();
+}
+
+
+void primitive_print(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}, true));
+    primitive_print(context, args.data(), args.size());
 }
 
 
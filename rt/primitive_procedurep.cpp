@@ -45,7 +45,7 @@ void primitive_procedurep(lpp::lpp__context::pointer_t context)
                             , "the :NAME argument is not expected to be empty.");
     }
     lpp::lpp__procedure_info_t const * proc(lpp::find_procedure(name));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(proc != nullptr));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(proc != nullptr));
     context->set_return_value(result);
 }
 
@@ -30,7 +30,7 @@
 void primitive_procedures(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::vector_t list(lpp::get_procedures(lpp::PROCEDURE_FLAG_PROCEDURE));
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
     context->set_return_value(result);
 }
 
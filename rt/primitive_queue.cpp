@@ -72,9 +72,7 @@ void primitive_queue(lpp::lpp__context::pointer_t context)
     {
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t list(data->get_list());
-            list.push_back(thing);
-            context->set_thing(name, std::make_shared<lpp::lpp__value>(list));
+            context->set_thing(name, lpp::lpp__make_value(data->get_list().lput(thing)));
         }
         break;
 
@@ -102,7 +100,7 @@ void primitive_queue(lpp::lpp__context::pointer_t context)
             std::string word(data->to_word());
 
             word += letter;
-            context->set_thing(name, std::make_shared<lpp::lpp__value>(word));
+            context->set_thing(name, lpp::lpp__make_value(word));
         }
         break;
 
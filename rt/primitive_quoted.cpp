@@ -32,7 +32,7 @@ void primitive_quoted(lpp::lpp__context::pointer_t context)
     lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
     if(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD)
     {
-        lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>('"' + thing->get_word()));
+        lpp::lpp__value::pointer_t result(lpp::lpp__make_value('"' + thing->get_word()));
         context->set_return_value(result);
     }
     else
@@ -22,6 +22,7 @@
 
 // C++ lib
 //
+#include <cmath>
 #include <iostream>
 
 
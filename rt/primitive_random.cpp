@@ -59,7 +59,7 @@ void primitive_random(lpp::lpp__context::pointer_t context)
     lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
     if(rest != nullptr)
     {
-        lpp::lpp__value::vector_t const & items(rest->get_value()->get_list());
+        lpp::lpp__value::list_t const & items(rest->get_value()->get_list());
         if(!items.empty())
         {
             if(items.size() > 1)
@@ -80,7 +80,7 @@ void primitive_random(lpp::lpp__context::pointer_t context)
             }
             lpp::lpp__integer_t e(end.get_integer());
             lpp::lpp__integer_t r(rnd() % (e - s + 1) + s);
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(r));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(r));
             context->set_return_value(result);
             return;
         }
@@ -90,7 +90,7 @@ void primitive_random(lpp::lpp__context::pointer_t context)
     //
     {
         lpp::lpp__integer_t r(rnd() % s);
-        lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(r));
+        lpp::lpp__value::pointer_t result(lpp::lpp__make_value(r));
         context->set_return_value(result);
     }
 }
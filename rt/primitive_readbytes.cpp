@@ -38,7 +38,7 @@ void primitive_readbytes(lpp::lpp__context::pointer_t context)
     {
         list.push_back(lpp::lpp__read_file(context, filename->to_word(), lpp::read_mode_t::READ_MODE_BYTE));
     }
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
     context->set_return_value(result);
 }
 
@@ -38,7 +38,7 @@ void primitive_readchars(lpp::lpp__context::pointer_t context)
     {
         word += lpp::lpp__read_file(context, filename->to_word(), lpp::read_mode_t::READ_MODE_CHAR)->get_word();
     }
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word));
     context->set_return_value(result);
 }
 
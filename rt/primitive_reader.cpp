@@ -30,7 +30,7 @@
 
 void primitive_reader(lpp::lpp__context::pointer_t context)
 {
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(lpp::lpp__get_reader()));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(lpp::lpp__get_reader()));
     context->set_return_value(result);
 }
 
@@ -32,7 +32,7 @@ void primitive_remove(lpp::lpp__context::pointer_t context)
     lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
     lpp::lpp__value::pointer_t list(context->get_thing("list")->get_value());
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>());
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value());
 
     switch(list->type())
     {
@@ -65,7 +65,7 @@ void primitive_remove(lpp::lpp__context::pointer_t context)
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t l(list->get_list());
+            lpp::lpp__value::vector_t l(list->get_list().to_vector());
             size_t idx(l.size());
             while(idx > 0)
             {
@@ -30,7 +30,7 @@
 void primitive_repcount(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__integer_t count(context->get_repeat_count());
-    lpp::lpp__value::pointer_t value(std::make_shared<lpp::lpp__value>(count));
+    lpp::lpp__value::pointer_t value(lpp::lpp__make_value(count));
     context->set_return_value(value);
 }
 
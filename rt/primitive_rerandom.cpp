@@ -33,7 +33,7 @@ void primitive_rerandom(lpp::lpp__context::pointer_t context)
     lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
     if(rest != nullptr)
     {
-        lpp::lpp__value::vector_t const & items(rest->get_value()->get_list());
+        lpp::lpp__value::list_t const & items(rest->get_value()->get_list());
         if(!items.empty())
         {
             if(items.size() > 1)
@@ -39,16 +39,16 @@ void primitive_reverse(lpp::lpp__context::pointer_t context)
         {
             std::string word(thing->to_word());
             std::reverse(word.begin(), word.end());
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word));
             context->set_return_value(result);
         }
         break;
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::vector_t list(thing->get_list());
+            lpp::lpp__value::vector_t list(thing->get_list().to_vector());
             std::reverse(list.begin(), list.end());
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
             context->set_return_value(result);
         }
         break;
@@ -77,11 +77,11 @@ void primitive_rseq(lpp::lpp__context::pointer_t context)
     list.reserve(count);
     for(lpp::lpp__integer_t idx(0); idx < count; ++idx)
     {
-        lpp::lpp__value::pointer_t value(std::make_shared<lpp::lpp__value>(gap * static_cast<lpp::lpp__float_t>(idx) + start));
+        lpp::lpp__value::pointer_t value(lpp::lpp__make_value(gap * static_cast<lpp::lpp__float_t>(idx) + start));
         list.push_back(value);
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
 
     context->set_return_value(result);
 }
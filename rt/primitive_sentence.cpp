@@ -27,47 +27,50 @@
 
 
 
-void primitive_sentence(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_sentence(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(context);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
 
-    lpp::lpp__value::vector_t list;
+    // start from the first list as is so a sentence that grows one
+    // item at a time does not copy the whole list each time
+    //
+    lpp::lpp__value::list_t list;
     if(thing->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
     {
         list = thing->get_list();
     }
     else
     {
-        list.push_back(thing);
+        list = list.lput(thing);
     }
 
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
+    for(std::size_t idx(1); idx < argc; ++idx)
     {
-        lpp::lpp__value::pointer_t r(rest->get_value());
-        if(r->type() != lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
-        {
-            throw lpp::lpp__error(context
-                                , lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM
-                                , "logic"
-                                , "the :REST argument is expected to always be a list.");
-        }
-        lpp::lpp__value::vector_t l(r->get_list());
-        for(auto item : l)
+        lpp::lpp__value::pointer_t const & item(args[idx]);
+        if(item->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
         {
-            if(item->type() == lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
+            for(auto sub_item : item->get_list())
             {
-                list.insert(list.end(), item->get_list().begin(), item->get_list().end());
-            }
-            else
-            {
-                list.push_back(item);
+                list = list.lput(sub_item);
             }
         }
+        else
+        {
+            list = list.lput(item);
+        }
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
-    context->set_return_value(result);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
+    return result;
+}
+
+
+void primitive_sentence(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}, true));
+    context->set_return_value(primitive_sentence(context, args.data(), args.size()));
 }
 
 
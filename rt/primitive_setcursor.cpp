@@ -38,7 +38,7 @@ void primitive_setcursor(lpp::lpp__context::pointer_t context)
                             , "error"
                             , "\"setcursor\" expects a list as its first parameter.");
     }
-    lpp::lpp__value::vector_t const & list(position->get_list());
+    lpp::lpp__value::list_t const & list(position->get_list());
 
     if(list.size() < 2)
     {
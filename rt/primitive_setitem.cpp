@@ -40,7 +40,7 @@ void primitive_setitem(lpp::lpp__context::pointer_t context)
                             , "\"setitem\" first parameter must be a number.");
     }
 
-    list = std::make_shared<lpp::lpp__value>(list->get_list());
+    list = lpp::lpp__make_value(list->get_list());
     context->set_return_value(list);
 
     if(list->type() != lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
@@ -61,7 +61,7 @@ void primitive_setitem(lpp::lpp__context::pointer_t context)
     }
     --pos;     // C++ position start at 0
 
-    lpp::lpp__value::vector_t l(list->get_list());
+    lpp::lpp__value::vector_t l(list->get_list().to_vector());
     if(static_cast<size_t>(pos) >= l.size())
     {
         throw lpp::lpp__error(context
@@ -72,7 +72,7 @@ void primitive_shell(lpp::lpp__context::pointer_t context)
         {
             // TODO: add support for lists of words
             //
-            list.push_back(std::make_shared<lpp::lpp__value>(line));
+            list.push_back(lpp::lpp__make_value(line));
 
             line.clear();
             if(n != '\0')
@@ -88,10 +88,10 @@ void primitive_shell(lpp::lpp__context::pointer_t context)
 
     if(!line.empty())
     {
-        list.push_back(std::make_shared<lpp::lpp__value>(line));
+        list.push_back(lpp::lpp__make_value(line));
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(list));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(list));
     context->set_return_value(result);
 }
 
@@ -27,34 +27,28 @@
 
 
 
-void primitive_show(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_show(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__write_file(context, std::string(), thing->to_string(lpp::DISPLAY_FLAG_TYPED));
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
+    lpp::lpp__write_file(context, std::string(), args[0]->to_string(lpp::DISPLAY_FLAG_TYPED));
+
+    // We have to print each item "manually" otherwise it adds
+    // the :REST list is an internal details
+    //
+    for(std::size_t idx(1); idx < argc; ++idx)
     {
-        auto rest_value(rest->get_value());
-        if(rest_value->type() != lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)
-        {
-            throw lpp::lpp__error(context
-                                , lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM
-                                , "logic"
-                                , "the :REST argument is expected to always be a list.");
-        }
-        auto const & list(rest_value->get_list());
-        size_t const max(list.size());
-
-        // We have to print each item "manually" otherwise it adds
-        // the :REST list is an internal details
-        //
-        for(size_t idx(0); idx < max; ++idx)
-        {
-            lpp::lpp__write_file(context, std::string(), " ");
-            lpp::lpp__write_file(context, std::string(), list[idx]->to_string(lpp::DISPLAY_FLAG_TYPED));
-        }
+        lpp::lpp__write_file(context, std::string(), " ");
+        lpp::lpp__write_file(context, std::string(), args[idx]->to_string(lpp::DISPLAY_FLAG_TYPED));
     }
     lpp::lpp__write_file(context, std::string(), "\n");
+
+    return lpp::lpp__value::pointer_t();
+}
+
+
+void primitive_show(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}, true));
+    primitive_show(context, args.data(), args.size());
 }
 
 
@@ -50,14 +50,14 @@ void primitive_substringp(lpp::lpp__context::pointer_t context)
             std::string word1(thing1->to_word());
             std::string word2(thing2->to_word());
             std::string::size_type pos(word2.find(word1));
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(pos != std::string::npos));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(pos != std::string::npos));
             context->set_return_value(result);
         }
         break;
 
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST:
         {
-            lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(false));
+            lpp::lpp__value::pointer_t result(lpp::lpp__make_value(false));
             context->set_return_value(result);
         }
         break;
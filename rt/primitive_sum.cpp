@@ -31,10 +31,18 @@ namespace
 template<typename T>
 T operation(lpp::lpp__context::pointer_t , T lhs, T rhs)
 {
-    // TODO: handle overflow/underflow
     return lhs + rhs;
 }
 
+
+// the integers must not silently overflow
+//
+template<>
+lpp::lpp__integer_t operation(lpp::lpp__context::pointer_t context, lpp::lpp__integer_t lhs, lpp::lpp__integer_t rhs)
+{
+    return lpp::lpp__number::add(context, lhs, rhs);
+}
+
 } // no name namespace
 
 
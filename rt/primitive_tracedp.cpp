@@ -31,7 +31,7 @@ void primitive_tracedp(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::pointer_t name(context->get_thing("name")->get_value());
 
-    context->set_return_value(std::make_shared<lpp::lpp__value>(context->is_traced(name->to_word())));
+    context->set_return_value(lpp::lpp__make_value(context->is_traced(name->to_word())));
 }
 
 
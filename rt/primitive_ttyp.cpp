@@ -31,7 +31,7 @@
 
 void primitive_ttyp(lpp::lpp__context::pointer_t context)
 {
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(lpp::lpp__tty_isatty()));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(lpp::lpp__tty_isatty()));
     context->set_return_value(result);
 }
 
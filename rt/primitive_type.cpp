@@ -27,23 +27,23 @@
 
 
 
-void primitive_type(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_type(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
-    lpp::lpp__write_file(context, std::string(), thing);
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
+    // no spaces between each element
+    //
+    for(std::size_t idx(0); idx < argc; ++idx)
     {
-        // go through the list because we need to not have spaces between
-        // each element
-        //
-        auto list(rest->get_value()->get_list());
-        size_t const max(list.size());
-        for(size_t i(0); i < max; ++i)
-        {
-            lpp::lpp__write_file(context, std::string(), list[i]);
-        }
+        lpp::lpp__write_file(context, std::string(), args[idx]);
     }
+
+    return lpp::lpp__value::pointer_t();
+}
+
+
+void primitive_type(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}, true));
+    primitive_type(context, args.data(), args.size());
 }
 
 
@@ -43,7 +43,7 @@ void primitive_unicode(lpp::lpp__context::pointer_t context)
 
     lpp::utf8_iterator w(word);
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>(*w)));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>(*w)));
 
     context->set_return_value(result);
 }
@@ -38,7 +38,7 @@ void primitive_untrace(lpp::lpp__context::pointer_t context)
                             , "the first argument of \"untrace\" is expected to be a list.");
     }
 
-    lpp::lpp__value::vector_t const & l(list->get_list());
+    lpp::lpp__value::list_t const & l(list->get_list());
     size_t const max(l.size());
     for(size_t i(0); i < max; ++i)
     {
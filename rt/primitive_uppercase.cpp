@@ -42,7 +42,7 @@ void primitive_uppercase(lpp::lpp__context::pointer_t context)
         ++it;
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(str));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(str));
     context->set_return_value(result);
 }
 
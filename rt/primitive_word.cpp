@@ -27,26 +27,25 @@
 
 
 
-void primitive_word(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_word(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t w1(context->get_thing("word1")->get_value());
-    std::string word(w1->to_word());
-
-    lpp::lpp__value::pointer_t w2(context->get_thing("word2")->get_value());
-    word += w2->to_word();
+    static_cast<void>(context);
 
-    lpp::lpp__thing::pointer_t rest(context->find_thing("rest"));
-    if(rest != nullptr)
+    std::string word;
+    for(std::size_t idx(0); idx < argc; ++idx)
     {
-        lpp::lpp__value::vector_t const & items(rest->get_value()->get_list());
-        for(auto const & r : items)
-        {
-            word += r->to_word();
-        }
+        word += args[idx]->to_word();
     }
 
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(word));
-    context->set_return_value(result);
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(word));
+    return result;
+}
+
+
+void primitive_word(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"word1", "word2"}, true));
+    context->set_return_value(primitive_word(context, args.data(), args.size()));
 }
 
 
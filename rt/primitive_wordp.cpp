@@ -27,9 +27,12 @@
 
 
 
-void primitive_wordp(lpp::lpp__context::pointer_t context)
+lpp::lpp__value::pointer_t primitive_wordp(lpp::lpp__context::pointer_t context, lpp::lpp__value::pointer_t const * args, std::size_t argc)
 {
-    lpp::lpp__value::pointer_t thing(context->get_thing("thing")->get_value());
+    static_cast<void>(context);
+    static_cast<void>(argc);
+
+    lpp::lpp__value::pointer_t const & thing(args[0]);
     lpp::lpp__value::pointer_t result;
     switch(thing->type())
     {
@@ -37,15 +40,22 @@ void primitive_wordp(lpp::lpp__context::pointer_t context)
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:
     case lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD:
-        result = std::make_shared<lpp::lpp__value>(true);
+        result = lpp::lpp__make_value(true);
         break;
 
     default:
-        result = std::make_shared<lpp::lpp__value>(false);
+        result = lpp::lpp__make_value(false);
         break;
 
     }
-    context->set_return_value(result);
+    return result;
+}
+
+
+void primitive_wordp(lpp::lpp__context::pointer_t context)
+{
+    lpp::lpp__value::vector_t const args(context->get_arguments({"thing"}));
+    context->set_return_value(primitive_wordp(context, args.data(), args.size()));
 }
 
 
@@ -31,7 +31,7 @@
 void primitive_writepos(lpp::lpp__context::pointer_t context)
 {
     lpp::lpp__value::pointer_t filename(context->get_thing("filename")->get_value());
-    lpp::lpp__value::pointer_t result(std::make_shared<lpp::lpp__value>(lpp::lpp__write_position(context, filename->to_word())));
+    lpp::lpp__value::pointer_t result(lpp::lpp__make_value(lpp::lpp__write_position(context, filename->to_word())));
     context->set_return_value(result);
 }
 
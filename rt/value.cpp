@@ -22,6 +22,7 @@
 
 // C++ lib
 //
+#include <cmath>
 #include <sstream>
 
 
@@ -32,57 +33,222 @@ namespace lpp
 
 
 lpp__value::lpp__value(lpp__special_value_t value)
-    : f_value(value)
 {
+    f_payload.f_special = value;
 }
 
 
 lpp__value::lpp__value(bool value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)
 {
+    f_payload.f_boolean = value;
 }
 
 
 lpp__value::lpp__value(lpp__integer_t value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_INTEGER)
 {
+    f_payload.f_integer = value;
 }
 
 
 lpp__value::lpp__value(lpp__float_t value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_FLOAT)
 {
+    f_payload.f_float = value;
 }
 
 
 lpp__value::lpp__value(std::string const & value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_WORD)
 {
+    f_payload.f_word = new shared_t<std::string>(value);
 }
 
 
 lpp__value::lpp__value(vector_t const & value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_LIST)
 {
+    f_payload.f_list = new shared_t<list_t>(list_t(value));
+}
+
+
+lpp__value::lpp__value(list_t const & value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_LIST)
+{
+    f_payload.f_list = new shared_t<list_t>(value);
 }
 
 
 lpp__value::lpp__value(map_t const & value)
-    : f_value(value)
+    : f_type(lpp__value_type_t::LPP__VALUE_TYPE_PROPERTY_LIST)
+{
+    f_payload.f_prop = new shared_t<map_t>(value);
+}
+
+
+/** \brief Copy a value.
+ *
+ * The words, lists and property lists are shared, not duplicated.
+ * The reference counter of the new value starts at zero like any
+ * other new value.
+ *
+ * \param[in] rhs  The value to copy.
+ */
+lpp__value::lpp__value(lpp__value const & rhs)
+    : f_type(rhs.f_type)
+    , f_payload(rhs.f_payload)
+{
+    acquire_payload();
+}
+
+
+lpp__value::~lpp__value()
+{
+    release_payload();
+}
+
+
+lpp__value & lpp__value::operator = (lpp__value const & rhs)
 {
+    check_writable();
+    if(this != &rhs)
+    {
+        release_payload();
+        f_type = rhs.f_type;
+        f_payload = rhs.f_payload;
+        acquire_payload();
+    }
+    return *this;
+}
+
+
+void * lpp__value::operator new (std::size_t size)
+{
+    if(size != sizeof(lpp__value))
+    {
+        throw std::logic_error("lpp__value::operator new() called with an unexpected size.");
+    }
+
+    return lpp__pool<sizeof(lpp__value)>::allocate();
+}
+
+
+void lpp__value::operator delete (void * ptr)
+{
+    if(ptr != nullptr)
+    {
+        lpp__pool<sizeof(lpp__value)>::release(ptr);
+    }
+}
+
+
+void lpp__value::check_type(lpp__value_type_t type) const
+{
+    if(f_type != type)
+    {
+        throw std::logic_error("lpp__value accessed with the wrong type.");
+    }
+}
+
+
+/** \brief Make sure the value can be modified.
+ *
+ * Constants are shared between all the executions of the code which
+ * uses them, modifying one would change the literal itself.
+ */
+void lpp__value::check_writable() const
+{
+    if(f_constant)
+    {
+        throw std::logic_error("attempt to modify a constant lpp__value.");
+    }
+}
+
+
+void lpp__value::acquire_payload()
+{
+    switch(f_type)
+    {
+    case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
+        ++f_payload.f_word->f_refcount;
+        break;
+
+    case lpp__value_type_t::LPP__VALUE_TYPE_LIST:
+        ++f_payload.f_list->f_refcount;
+        break;
+
+    case lpp__value_type_t::LPP__VALUE_TYPE_PROPERTY_LIST:
+        ++f_payload.f_prop->f_refcount;
+        break;
+
+    default:
+        break;
+
+    }
+}
+
+
+void lpp__value::release_payload()
+{
+    switch(f_type)
+    {
+    case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
+        --f_payload.f_word->f_refcount;
+        if(f_payload.f_word->f_refcount == 0)
+        {
+            delete f_payload.f_word;
+        }
+        break;
+
+    case lpp__value_type_t::LPP__VALUE_TYPE_LIST:
+        --f_payload.f_list->f_refcount;
+        if(f_payload.f_list->f_refcount == 0)
+        {
+            delete f_payload.f_list;
+        }
+        break;
+
+    case lpp__value_type_t::LPP__VALUE_TYPE_PROPERTY_LIST:
+        --f_payload.f_prop->f_refcount;
+        if(f_payload.f_prop->f_refcount == 0)
+        {
+            delete f_payload.f_prop;
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_SPECIAL;
+    f_payload.f_special = lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET;
+}
+
+
+void lpp__value::set_constant()
+{
+    f_constant = true;
+}
+
+
+bool lpp__value::is_constant() const
+{
+    return f_constant;
 }
 
 
 lpp__value_type_t lpp__value::type() const
 {
-    return static_cast<lpp__value_type_t>(f_value.which());
+    return f_type;
 }
 
 
 bool lpp__value::is_set() const
 {
-    return type() != lpp__value_type_t::LPP__VALUE_TYPE_SPECIAL
-        || boost::get<lpp__special_value_t>(f_value) != lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET;
+    return f_type != lpp__value_type_t::LPP__VALUE_TYPE_SPECIAL
+        || f_payload.f_special != lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET;
 }
 
 
@@ -115,7 +281,7 @@ bool lpp__value::represents_integer() const
     case lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:
         {
             double integral_part(0.0);
-            double fraction(modf(boost::get<lpp__float_t>(f_value), &integral_part));
+            double fraction(modf(f_payload.f_float, &integral_part));
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wfloat-equal"
             if(fraction == 0.0)
@@ -128,7 +294,7 @@ bool lpp__value::represents_integer() const
 
     case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
         {
-            std::string const word(boost::get<std::string>(f_value));
+            std::string const word(f_payload.f_word->f_data);
             char * end(nullptr);
             static_cast<void>(std::strtoll(word.c_str(), &end, 10));
             return end != nullptr
@@ -155,7 +321,7 @@ bool lpp__value::represents_float() const
 
     case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
         {
-            std::string const str(boost::get<std::string>(f_value));
+            std::string const str(f_payload.f_word->f_data);
             char * end(nullptr);
             static_cast<void>(strtod(str.c_str(), &end));
             return end != nullptr
@@ -174,79 +340,116 @@ bool lpp__value::represents_float() const
 
 bool lpp__value::get_boolean() const
 {
-    return boost::get<bool>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN);
+    return f_payload.f_boolean;
 }
 
 
 lpp__integer_t lpp__value::get_integer() const
 {
-    return boost::get<lpp__integer_t>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_INTEGER);
+    return f_payload.f_integer;
 }
 
 
 lpp__float_t lpp__value::get_float() const
 {
-    return boost::get<lpp__float_t>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_FLOAT);
+    return f_payload.f_float;
 }
 
 
 std::string const & lpp__value::get_word() const
 {
-    return boost::get<std::string>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_WORD);
+    return f_payload.f_word->f_data;
 }
 
 
-lpp__value::vector_t const & lpp__value::get_list() const
+lpp__value::list_t const & lpp__value::get_list() const
 {
-    return boost::get<vector_t>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_LIST);
+    return f_payload.f_list->f_data;
 }
 
 
 lpp__value::map_t const & lpp__value::get_prop() const
 {
-    return boost::get<map_t>(f_value);
+    check_type(lpp__value_type_t::LPP__VALUE_TYPE_PROPERTY_LIST);
+    return f_payload.f_prop->f_data;
 }
 
 
 void lpp__value::unset()
 {
-    f_value = lpp__special_value_t::LPP__SPECIAL_VALUE_NOT_SET;
+    check_writable();
+    release_payload();
 }
 
 
 void lpp__value::set_boolean(bool value)
 {
-    f_value = value;
+    check_writable();
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN;
+    f_payload.f_boolean = value;
 }
 
 
 void lpp__value::set_integer(lpp__integer_t value)
 {
-    f_value = value;
+    check_writable();
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_INTEGER;
+    f_payload.f_integer = value;
 }
 
 
 void lpp__value::set_float(lpp__float_t value)
 {
-    f_value = value;
+    check_writable();
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_FLOAT;
+    f_payload.f_float = value;
 }
 
 
 void lpp__value::set_word(std::string const & value)
 {
-    f_value = value;
+    check_writable();
+
+    // create first, value may be a reference to our own word
+    //
+    shared_t<std::string> * word(new shared_t<std::string>(value));
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_WORD;
+    f_payload.f_word = word;
 }
 
 
 void lpp__value::set_list(vector_t const & value)
 {
-    f_value = value;
+    set_list(list_t(value));
+}
+
+
+void lpp__value::set_list(list_t const & value)
+{
+    check_writable();
+    shared_t<list_t> * list(new shared_t<list_t>(value));
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_LIST;
+    f_payload.f_list = list;
 }
 
 
 void lpp__value::set_prop(map_t const & value)
 {
-    f_value = value;
+    check_writable();
+    shared_t<map_t> * prop(new shared_t<map_t>(value));
+    release_payload();
+    f_type = lpp__value_type_t::LPP__VALUE_TYPE_PROPERTY_LIST;
+    f_payload.f_prop = prop;
 }
 
 
@@ -287,7 +490,7 @@ std::string lpp__value::to_string(display_flag_t flags, int depth) const
             ss << "[";
         }
         {
-            auto list(get_list());
+            auto const & list(get_list());
             size_t const max(list.size());
             if(max > 0)
             {
@@ -359,12 +562,12 @@ lpp__integer_t lpp__value::to_integer() const
     switch(type())
     {
     case lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:
-        return boost::get<lpp__float_t>(f_value);
+        return f_payload.f_integer;
 
     case lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:
         {
             double integral_part(0.0);
-            double fraction(modf(boost::get<lpp__float_t>(f_value), &integral_part));
+            double fraction(modf(f_payload.f_float, &integral_part));
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wfloat-equal"
             if(fraction == 0.0)
@@ -378,7 +581,7 @@ lpp__integer_t lpp__value::to_integer() const
 
     case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
         {
-            std::string const word(boost::get<std::string>(f_value));
+            std::string const word(f_payload.f_word->f_data);
             char * end(nullptr);
             lpp__integer_t const value(std::strtoll(word.c_str(), &end, 10));
             if(end != nullptr
@@ -406,14 +609,14 @@ lpp__float_t lpp__value::to_float() const
     switch(type())
     {
     case lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:
-        return boost::get<lpp__integer_t>(f_value);
+        return f_payload.f_integer;
 
     case lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:
-        return boost::get<lpp__float_t>(f_value);
+        return f_payload.f_float;
 
     case lpp__value_type_t::LPP__VALUE_TYPE_WORD:
         {
-            std::string const word(boost::get<std::string>(f_value));
+            std::string const word(f_payload.f_word->f_data);
             char * end(nullptr);
             lpp__float_t value(strtod(word.c_str(), &end));
             if(end != nullptr
@@ -438,13 +641,10 @@ lpp__float_t lpp__value::to_float() const
 void lpp__value::add_prop(std::string const & name
                         , lpp__value::pointer_t value)
 {
-    vector_t & list(boost::get<vector_t>(f_value));
-
-    lpp__value::pointer_t prop_name(std::make_shared<lpp::lpp__value>());
+    lpp__value::pointer_t prop_name(lpp__make_value());
     prop_name->set_word(name);
-    list.push_back(prop_name);
 
-    list.push_back(value);
+    set_list(get_list().lput(prop_name).lput(value));
 }
 
 
@@ -30,9 +30,31 @@
 
 // C++ lib
 //
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <set>
 #include <sstream>
+#include <thread>
+
+// C lib
+//
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
 
 
 
@@ -41,6 +63,163 @@ namespace lpp
 {
 
 
+namespace
+{
+
+
+bool read_file(std::string const & filename, std::string & content)
+{
+    std::ifstream in(filename);
+    if(!in.is_open())
+    {
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+
+/** \brief Create a directory and its parents.
+ *
+ * \param[in] path  The directory to create.
+ *
+ * \return true if the directory exists once the function returns.
+ */
+bool make_directory(std::string const & path)
+{
+    for(std::string::size_type pos(path.find('/', 1));; pos = path.find('/', pos + 1))
+    {
+        std::string const part(path.substr(0, pos));
+        if(mkdir(part.c_str(), 0755) != 0
+        && errno != EEXIST)
+        {
+            return false;
+        }
+        if(pos == std::string::npos)
+        {
+            break;
+        }
+    }
+
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+
+/** \brief Compute the 64 bit FNV-1a hash of \p data.
+ *
+ * \param[in] hash  The hash so far, so multiple buffers can be hashed
+ *                  as one.
+ * \param[in] data  The buffer to add to the hash.
+ *
+ * \return The updated hash.
+ */
+std::uint64_t fnv1a(std::uint64_t hash, std::string const & data)
+{
+    for(auto c : data)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+
+/** \brief Check whether \p name was created by the object cache.
+ *
+ * The cache directory may be shared with other files (--cache-dir) so
+ * only the names the cache creates get pruned: 16 hexadecimal digits
+ * followed by ".o", ".pch" or the ".o.<pid>" of an interrupted g++.
+ *
+ * \param[in] name  The name of a file in the cache directory.
+ *
+ * \return true if the file is an entry of the cache.
+ */
+bool is_cache_entry(std::string const & name)
+{
+    if(name.length() < 18)
+    {
+        return false;
+    }
+    for(std::string::size_type idx(0); idx < 16; ++idx)
+    {
+        if(!isxdigit(static_cast<unsigned char>(name[idx])))
+        {
+            return false;
+        }
+    }
+    std::string const extension(name.substr(16));
+    return extension == ".o"
+        || extension == ".pch"
+        || (extension.compare(0, 3, ".o.") == 0
+            && extension.find_first_not_of("0123456789", 3) == std::string::npos);
+}
+
+
+/** \brief Remove a file or a directory and its content.
+ *
+ * \param[in] path  The file or directory to remove.
+ */
+void remove_tree(std::string const & path)
+{
+    DIR * dir(opendir(path.c_str()));
+    if(dir == nullptr)
+    {
+        unlink(path.c_str());
+        return;
+    }
+    for(struct dirent * entry(readdir(dir)); entry != nullptr; entry = readdir(dir))
+    {
+        std::string const name(entry->d_name);
+        if(name != "."
+        && name != "..")
+        {
+            remove_tree(path + "/" + name);
+        }
+    }
+    closedir(dir);
+    rmdir(path.c_str());
+}
+
+
+/** \brief Remove the objects compiled without the cache.
+ *
+ * With --no-cache the objects are compiled in a temporary directory
+ * which gets deleted once the program is linked, whether the build
+ * succeeded or not.
+ */
+class temporary_objects
+{
+public:
+    temporary_objects(std::string const & dir)
+        : f_dir(dir)
+    {
+    }
+
+    temporary_objects(temporary_objects const &) = delete;
+
+    ~temporary_objects()
+    {
+        if(!f_dir.empty())
+        {
+            remove_tree(f_dir);
+        }
+    }
+
+    temporary_objects & operator = (temporary_objects const &) = delete;
+
+private:
+    std::string const   f_dir;
+};
+
+
+
+}
+// no name namespace
+
+
 Compiler::Compiler()
 {
 }
@@ -82,6 +261,74 @@ void Compiler::set_include_debug(bool status)
 }
 
 
+/** \brief Set the optimization level passed to g++.
+ *
+ * The \p level is the part that follows the "-O" of the g++ option.
+ * It can be one of "0", "1", "2", "3", or "s". Anything else is
+ * considered invalid and generates an error.
+ *
+ * The default is "0" which is best when debugging the output.
+ *
+ * \param[in] level  The optimization level.
+ */
+void Compiler::set_optimization_level(std::string const & level)
+{
+    if(level != "0"
+    && level != "1"
+    && level != "2"
+    && level != "3"
+    && level != "s")
+    {
+        throw lpp_error("unsupported optimization level \""
+                      + level
+                      + "\"; expected 0, 1, 2, 3, or s.");
+    }
+
+    f_optimization_level = level;
+}
+
+
+/** \brief Get the optimization level.
+ *
+ * The command line also uses this level to know whether the Logo
+ * code itself gets optimized before the C++ code gets generated.
+ *
+ * \return The optimization level as passed to g++ after "-O".
+ */
+std::string const & Compiler::get_optimization_level() const
+{
+    return f_optimization_level;
+}
+
+
+void Compiler::set_march_native(bool status)
+{
+    f_march_native = status;
+}
+
+
+void Compiler::set_lto(bool status)
+{
+    f_lto = status;
+}
+
+
+/** \brief Link a static executable.
+ *
+ * The executable gets linked against the static version of the
+ * runtime (liblpprt.a) and the static C and C++ libraries. Along with
+ * set_lto() it uses liblpprt-lto.a instead, which holds the LTO
+ * bytecode of the runtime so g++ can inline the primitives in the
+ * generated code.
+ *
+ * \param[in] status  Whether to link a static executable.
+ */
+void Compiler::set_static(bool status)
+{
+    f_static = status;
+}
+
+
 void Compiler::add_include_path(std::string const & path)
 {
     f_include_paths.push_back(path);
@@ -106,48 +353,275 @@ void Compiler::add_library(std::string const & path)
 }
 
 
+void Compiler::add_source(std::string const & path)
+{
+    f_sources.push_back(path);
+}
+
+
+/** \brief Turn the object cache on or off.
+ *
+ * When the cache is turned off, all the units get compiled in a
+ * temporary directory which is deleted once the program is linked.
+ *
+ * \param[in] status  Whether the objects get cached.
+ */
+void Compiler::set_cache(bool status)
+{
+    f_cache = status;
+}
+
+
+/** \brief Set the directory where the objects get cached.
+ *
+ * By default the objects are saved under $XDG_CACHE_HOME/lpp or
+ * $HOME/.cache/lpp when XDG_CACHE_HOME is not defined.
+ *
+ * \param[in] path  The path to the cache directory.
+ */
+void Compiler::set_cache_dir(std::string const & path)
+{
+    f_cache_dir = path;
+}
+
+
+std::string Compiler::get_cache_dir() const
+{
+    if(!f_cache_dir.empty())
+    {
+        return f_cache_dir;
+    }
+
+    char const * xdg_cache(getenv("XDG_CACHE_HOME"));
+    if(xdg_cache != nullptr
+    && *xdg_cache != '\0')
+    {
+        return std::string(xdg_cache) + "/lpp";
+    }
+
+    char const * home(getenv("HOME"));
+    if(home != nullptr
+    && *home != '\0')
+    {
+        return std::string(home) + "/.cache/lpp";
+    }
+
+    return std::string(".lpp-cache");
+}
+
+
+/** \brief Set how long unused objects stay in the cache.
+ *
+ * Each build removes the objects and precompiled headers which were
+ * not used for that many days. By default that is 30 days. Zero keeps
+ * them forever.
+ *
+ * \param[in] days  The number of days.
+ */
+void Compiler::set_cache_max_age(std::string const & days)
+{
+    std::size_t age(0);
+    for(auto c : days)
+    {
+        if(c < '0' || c > '9' || age > 100000)
+        {
+            throw lpp_error("unsupported cache age \""
+                          + days
+                          + "\"; expected a number of days.");
+        }
+        age = age * 10 + c - '0';
+    }
+    if(days.empty())
+    {
+        throw lpp_error("unsupported cache age \"\"; expected a number of days.");
+    }
+
+    f_cache_max_age = age;
+}
+
+
+/** \brief Set the number of g++ processes to run in parallel.
+ *
+ * The \p count must be a positive number. By default the compiler
+ * runs as many processes as there are processors on the computer.
+ *
+ * \param[in] count  The maximum number of g++ processes to run at once.
+ */
+void Compiler::set_jobs(std::string const & count)
+{
+    std::size_t jobs(0);
+    for(auto c : count)
+    {
+        if(c < '0' || c > '9' || jobs > 1000)
+        {
+            jobs = 0;
+            break;
+        }
+        jobs = jobs * 10 + c - '0';
+    }
+    if(jobs == 0)
+    {
+        throw lpp_error("unsupported number of jobs \""
+                      + count
+                      + "\"; expected a positive number.");
+    }
+
+    f_jobs = jobs;
+}
+
+
+/** \brief Compile the generated C++ code and link the result.
+ *
+ * Each translation unit generated by the parser is compiled on its own
+ * and the object is saved in the cache directory under the hash of
+ * the compiler flags, the lpp.hpp header and the source. Since the
+ * parser generates the exact same code for a procedure which did not
+ * change, rebuilding a program after editing one procedure only
+ * recompiles that one procedure (and l.cpp when the list of procedures
+ * changed). The objects are then linked together.
+ *
+ * The units which are not yet cached get compiled in parallel (see
+ * set_jobs()). Once done, the entries of the cache which were not used
+ * for a while get removed (see set_cache_max_age()).
+ *
+ * \return The exit code of the last g++ command.
+ */
 int Compiler::compile()
 {
-    std::vector<std::string> option;
+    string_list_t flags;
 
     // compiler
     //
-    option.push_back("g++");
+    flags.push_back("g++");
 
     // standard
     //
-    option.push_back("-std=c++14");
+    flags.push_back("-std=c++14");
 
     // debug
     //
     if(f_include_debug)
     {
-        option.push_back("-g");
+        flags.push_back("-g");
     }
 
     // optimizations
     //
-    option.push_back("-O0");
+    flags.push_back("-O" + f_optimization_level);
+    if(f_march_native)
+    {
+        flags.push_back("-march=native");
+    }
+    if(f_lto)
+    {
+        // the flag is required at compile and link time
+        //
+        flags.push_back("-flto");
+    }
 
     // include paths
     //
+    std::string header;
+    std::string header_path;
     for(auto inc : f_include_paths)
     {
-        option.push_back("-I");
-        option.push_back(inc);
+        flags.push_back("-I");
+        flags.push_back(inc);
+
+        // the objects depend on the runtime header so it is part of
+        // the cache key
+        //
+        if(header_path.empty()
+        && read_file(inc + "/lpp/lpp.hpp", header))
+        {
+            header_path = inc;
+        }
     }
 
-    // the C++ input file
+    // the C++ input files
     //
-    option.push_back("l.cpp");
+    string_list_t sources(f_sources);
 
     // the main if necessary (i.e. "program ... end program;" block present)
     //
     if(f_has_program)
     {
-        option.push_back(f_main_cpp);
+        sources.push_back(f_main_cpp);
     }
 
+    std::string object_dir;
+    if(f_cache)
+    {
+        object_dir = get_cache_dir();
+        if(!make_directory(object_dir))
+        {
+            std::cerr << "error: could not create cache directory \""
+                      << object_dir
+                      << "\"; use --cache-dir to select another directory."
+                      << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        char const * tmpdir(getenv("TMPDIR"));
+        object_dir = tmpdir == nullptr || *tmpdir == '\0' ? "/tmp" : tmpdir;
+        object_dir += "/lpp-XXXXXX";
+        if(mkdtemp(&object_dir[0]) == nullptr)
+        {
+            std::cerr << "error: could not create a temporary directory for the objects."
+                      << std::endl;
+            return 1;
+        }
+    }
+    temporary_objects const cleanup(f_cache ? std::string() : object_dir);
+
+    f_reused_objects = 0;
+    f_compiled_objects = 0;
+    string_list_t objects;
+    job_list_t jobs;
+    for(auto const & source : sources)
+    {
+        job_t job;
+        job.f_source = source;
+        if(!find_object(flags, header, object_dir, job))
+        {
+            return 1;
+        }
+        objects.push_back(job.f_object);
+        if(job.f_size > 0)
+        {
+            jobs.push_back(job);
+        }
+    }
+
+    if(!jobs.empty())
+    {
+        string_list_t pch_flags;
+        if(!prepare_precompiled_header(flags, header_path, header, pch_flags)
+        || !compile_objects(flags, pch_flags, jobs))
+        {
+            return 1;
+        }
+    }
+
+    if(f_verbose)
+    {
+        std::cerr << "info: reused "
+                  << f_reused_objects
+                  << " cached object(s), compiled "
+                  << f_compiled_objects
+                  << " object(s)."
+                  << std::endl;
+    }
+
+    string_list_t option(flags);
+    if(f_static)
+    {
+        option.push_back("-static");
+    }
+    option.insert(option.end(), objects.begin(), objects.end());
+
     // include paths
     //
     for(auto rp : f_rpaths)
@@ -174,7 +648,22 @@ int Compiler::compile()
         option.push_back(lib);
     }
     option.push_back("-l");
-    option.push_back("lpprt");
+    option.push_back(f_static && f_lto ? "lpprt-lto" : "lpprt");
+    if(f_lto)
+    {
+        // run the LTRANS jobs in parallel like the compilation; with a
+        // single job there is no need to split the program
+        //
+        std::size_t const lto_jobs(get_jobs());
+        if(lto_jobs == 1)
+        {
+            option.push_back("-flto-partition=one");
+        }
+        else
+        {
+            option.push_back("-flto=" + std::to_string(lto_jobs));
+        }
+    }
 
     // output filename
     //
@@ -184,26 +673,532 @@ int Compiler::compile()
         option.push_back(f_output);
     }
 
-    // build the command
+    int const exit_code(link(option));
+
+    if(f_cache
+    && f_cache_max_age > 0)
+    {
+        prune_cache(object_dir);
+    }
+
+    return exit_code;
+}
+
+
+/** \brief Make sure a precompiled lpp.hpp matches the g++ options.
+ *
+ * The install ships precompiled headers for the default (-O0) and the
+ * release (-O2) options in the lpp/lpp.hpp.gch directory and g++ picks
+ * them up automatically. For any other set of options, the header gets
+ * precompiled once and saved in the cache directory, which is then
+ * added in front of the include paths so g++ finds it first.
+ *
+ * \param[in] flags  The g++ command line options.
+ * \param[in] include_path  The include path where lpp/lpp.hpp was found.
+ * \param[in] header  The content of the lpp.hpp header.
+ * \param[out] pch_flags  The options to add to the g++ command line.
+ *
+ * \return false if an error occurred.
+ */
+bool Compiler::prepare_precompiled_header(string_list_t const & flags, std::string const & include_path, std::string const & header, string_list_t & pch_flags)
+{
+    if(include_path.empty())
+    {
+        // without the header we have nothing to precompile
+        //
+        return true;
+    }
+
+    if(!f_include_debug
+    && !f_march_native
+    && !f_lto
+    && access((include_path + "/lpp/lpp.hpp.gch/O" + f_optimization_level + ".gch").c_str(), R_OK) == 0)
+    {
+        return true;
+    }
+
+    // without the cache, a precompiled header would be used only once
     //
-    std::string cmd;
-    for(auto o : option)
+    if(!f_cache)
+    {
+        return true;
+    }
+
+    std::string const separator(1, '\0');
+    std::uint64_t hash(0xCBF29CE484222325ULL);
+    for(auto const & f : flags)
+    {
+        hash = fnv1a(hash, f);
+        hash = fnv1a(hash, separator);
+    }
+    hash = fnv1a(hash, header);
+
+    std::stringstream name;
+    name << get_cache_dir()
+         << '/'
+         << std::hex
+         << std::setfill('0')
+         << std::setw(16)
+         << hash
+         << ".pch";
+    std::string const pch_dir(name.str());
+    std::string const pch(pch_dir + "/lpp/lpp.hpp.gch");
+
+    pch_flags.push_back("-I");
+    pch_flags.push_back(pch_dir);
+
+    if(access(pch.c_str(), R_OK) == 0)
+    {
+        // keep it from being pruned
+        //
+        utime(pch_dir.c_str(), nullptr);
+        return true;
+    }
+
+    if(!make_directory(pch_dir + "/lpp"))
+    {
+        std::cerr << "error: could not create directory \""
+                  << pch_dir
+                  << "/lpp\"."
+                  << std::endl;
+        return false;
+    }
+
+    std::string const tmp(pch + "." + std::to_string(getpid()));
+    string_list_t option(flags);
+    option.push_back("-x");
+    option.push_back("c++-header");
+    option.push_back(include_path + "/lpp/lpp.hpp");
+    option.push_back("-o");
+    option.push_back(tmp);
+    if(wait(spawn(option)) != 0
+    || rename(tmp.c_str(), pch.c_str()) != 0)
+    {
+        unlink(tmp.c_str());
+        std::cerr << "error: could not precompile \""
+                  << include_path
+                  << "/lpp/lpp.hpp\"."
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+/** \brief Find the object of one translation unit.
+ *
+ * If the cache already has an object for this very source compiled
+ * with the same flags, it gets reused as is. Otherwise the size of
+ * the source is saved in the job so it gets compiled.
+ *
+ * \param[in] flags  The g++ command line options.
+ * \param[in] header  The content of the lpp.hpp header.
+ * \param[in] object_dir  The cache or, without cache, the temporary
+ * directory where the object gets saved.
+ * \param[in,out] job  The job with the source to compile; the function
+ * sets the object path and the size (0 when the object is cached).
+ *
+ * \return true if the object is or can be made available.
+ */
+bool Compiler::find_object(string_list_t const & flags, std::string const & header, std::string const & object_dir, job_t & job)
+{
+    std::string content;
+    if(!read_file(job.f_source, content))
     {
-        if(!cmd.empty())
+        std::cerr << "error: could not read \""
+                  << job.f_source
+                  << "\"."
+                  << std::endl;
+        return false;
+    }
+
+    std::string const separator(1, '\0');
+    std::uint64_t hash(0xCBF29CE484222325ULL);
+    for(auto const & f : flags)
+    {
+        hash = fnv1a(hash, f);
+        hash = fnv1a(hash, separator);
+    }
+    hash = fnv1a(hash, header);
+    hash = fnv1a(hash, separator);
+    hash = fnv1a(hash, content);
+
+    std::stringstream name;
+    name << object_dir
+         << '/'
+         << std::hex
+         << std::setfill('0')
+         << std::setw(16)
+         << hash
+         << ".o";
+    job.f_object = name.str();
+
+    if(f_cache
+    && access(job.f_object.c_str(), R_OK) == 0)
+    {
+        // keep it from being pruned
+        //
+        utime(job.f_object.c_str(), nullptr);
+
+        ++f_reused_objects;
+        job.f_size = 0;
+    }
+    else
+    {
+        job.f_size = content.length() + 1;
+    }
+
+    return true;
+}
+
+
+/** \brief Compile the objects missing from the cache.
+ *
+ * The g++ processes run in parallel, up to the number of jobs specified
+ * with set_jobs(). The largest sources are started first so a large
+ * procedure does not end up compiling alone at the end.
+ *
+ * Each object is compiled to a temporary file and renamed once complete
+ * so another lpp running in parallel never sees a partial object.
+ *
+ * \param[in] flags  The g++ command line options.
+ * \param[in] pch_flags  The options selecting the precompiled header.
+ * \param[in,out] jobs  The sources to compile.
+ *
+ * \return true if all the objects were compiled successfully.
+ */
+bool Compiler::compile_objects(string_list_t const & flags, string_list_t const & pch_flags, job_list_t & jobs)
+{
+    std::stable_sort(
+              jobs.begin()
+            , jobs.end()
+            , [](job_t const & lhs, job_t const & rhs)
+              {
+                  return lhs.f_size > rhs.f_size;
+              });
+
+    std::size_t const max_jobs(get_jobs());
+
+    std::string const suffix("." + std::to_string(getpid()));
+    std::set<std::string> started;
+    std::map<pid_t, job_t const *> running;
+    bool success(true);
+    for(auto next(jobs.begin());;)
+    {
+        while(success
+           && next != jobs.end()
+           && running.size() < max_jobs)
+        {
+            job_t const & job(*next);
+            ++next;
+
+            // two identical units share the same object
+            //
+            if(!started.insert(job.f_object).second)
+            {
+                continue;
+            }
+
+            string_list_t option(flags);
+            option.insert(option.begin() + 1, pch_flags.begin(), pch_flags.end());
+            option.push_back("-c");
+            option.push_back(job.f_source);
+            option.push_back("-o");
+            option.push_back(job.f_object + suffix);
+            pid_t const pid(spawn(option));
+            if(pid == -1)
+            {
+                success = false;
+                break;
+            }
+            running[pid] = &job;
+        }
+
+        if(running.empty())
+        {
+            break;
+        }
+
+        int status(0);
+        pid_t const pid(waitpid(-1, &status, 0));
+        if(pid == -1)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            std::cerr << "error: waiting for g++ failed." << std::endl;
+            return false;
+        }
+        auto const it(running.find(pid));
+        if(it == running.end())
+        {
+            continue;
+        }
+        job_t const & job(*it->second);
+        running.erase(it);
+
+        std::string const tmp(job.f_object + suffix);
+        if(!WIFEXITED(status)
+        || WEXITSTATUS(status) != 0)
         {
-            cmd += " ";
+            unlink(tmp.c_str());
+            success = false;
+            continue;
         }
-        cmd += o;
+        if(rename(tmp.c_str(), job.f_object.c_str()) != 0)
+        {
+            unlink(tmp.c_str());
+            std::cerr << "error: could not save object \""
+                      << job.f_object
+                      << "\"."
+                      << std::endl;
+            success = false;
+            continue;
+        }
+
+        ++f_compiled_objects;
     }
 
+    return success;
+}
+
+
+/** \brief Get the number of g++ processes to run in parallel.
+ *
+ * \return The number of jobs set with set_jobs() or the number of
+ * processors when not set.
+ */
+std::size_t Compiler::get_jobs() const
+{
+    if(f_jobs != 0)
+    {
+        return f_jobs;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+
+/** \brief Start a command.
+ *
+ * \param[in] option  The command and its arguments.
+ * \param[in] error_fd  The file descriptor receiving the stderr of the
+ * command, -1 to keep ours.
+ *
+ * \return The process identifier of the command or -1 on error.
+ */
+pid_t Compiler::spawn(string_list_t const & option, int error_fd) const
+{
     if(f_verbose)
     {
+        std::string cmd;
+        for(auto const & o : option)
+        {
+            if(!cmd.empty())
+            {
+                cmd += " ";
+            }
+            cmd += o;
+        }
         std::cerr << cmd << std::endl;
     }
 
-    // run the command
+    std::vector<char *> argv;
+    for(auto const & o : option)
+    {
+        argv.push_back(const_cast<char *>(o.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if(error_fd != -1)
+    {
+        posix_spawn_file_actions_adddup2(&actions, error_fd, STDERR_FILENO);
+    }
+
+    pid_t pid(-1);
+    int const r(posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ));
+    posix_spawn_file_actions_destroy(&actions);
+    if(r != 0)
+    {
+        std::cerr << "error: could not start \""
+                  << option[0]
+                  << "\": "
+                  << strerror(r)
+                  << std::endl;
+        return -1;
+    }
+
+    return pid;
+}
+
+
+/** \brief Wait for a command to exit.
+ *
+ * \param[in] pid  The process identifier returned by spawn().
+ *
+ * \return The exit code of the command or 1 if it could not run.
+ */
+int Compiler::wait(pid_t pid) const
+{
+    if(pid == -1)
+    {
+        return 1;
+    }
+
+    int status(0);
+    while(waitpid(pid, &status, 0) == -1)
+    {
+        if(errno != EINTR)
+        {
+            return 1;
+        }
+    }
+
+    if(!WIFEXITED(status))
+    {
+        return 1;
+    }
+    return WEXITSTATUS(status);
+}
+
+
+/** \brief Run the link command.
+ *
+ * A static link makes ld warn about each glibc function which loads
+ * shared libraries at runtime (getpwuid() and getgrgid() used by
+ * FILEINFO). These warnings do not apply to a Logo program so on a
+ * static link the errors of g++ go through a pipe and these warnings
+ * get removed; everything else is printed as is.
+ *
+ * \param[in] option  The g++ command and its arguments.
+ *
+ * \return The exit code of g++.
+ */
+int Compiler::link(string_list_t const & option) const
+{
+    if(!f_static)
+    {
+        return wait(spawn(option));
+    }
+
+    int pipes[2];
+    if(pipe2(pipes, O_CLOEXEC) != 0)
+    {
+        std::cerr << "error: could not create a pipe: "
+                  << strerror(errno)
+                  << std::endl;
+        return 1;
+    }
+
+    pid_t const pid(spawn(option, pipes[1]));
+    close(pipes[1]);
+
+    std::string errors;
+    for(;;)
+    {
+        char buf[4096];
+        ssize_t const size(read(pipes[0], buf, sizeof(buf)));
+        if(size == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if(size <= 0)
+        {
+            break;
+        }
+        errors.append(buf, size);
+    }
+    close(pipes[0]);
+
+    // ld prints the name of the function on its own line before the
+    // first warning found in it
     //
-    return system(cmd.c_str());
+    std::istringstream in(errors);
+    std::string function;
+    std::string line;
+    std::size_t hidden(0);
+    while(std::getline(in, line))
+    {
+        if(line.find("in statically linked applications requires at runtime") != std::string::npos)
+        {
+            function.clear();
+            ++hidden;
+            continue;
+        }
+        if(!function.empty())
+        {
+            std::cerr << function << std::endl;
+            function.clear();
+        }
+        if(line.find(": in function `") != std::string::npos)
+        {
+            function = line;
+            continue;
+        }
+        std::cerr << line << std::endl;
+    }
+    if(!function.empty())
+    {
+        std::cerr << function << std::endl;
+    }
+
+    if(f_verbose
+    && hidden > 0)
+    {
+        std::cerr << "info: ignored "
+                  << hidden
+                  << " glibc static link warning(s)."
+                  << std::endl;
+    }
+
+    return wait(pid);
+}
+
+
+/** \brief Remove the old entries of the cache.
+ *
+ * The objects and precompiled headers get their time updated each time
+ * they are used. The ones which were not used for f_cache_max_age days
+ * are removed so the cache does not grow forever.
+ *
+ * \param[in] cache_dir  The cache directory.
+ */
+void Compiler::prune_cache(std::string const & cache_dir) const
+{
+    DIR * dir(opendir(cache_dir.c_str()));
+    if(dir == nullptr)
+    {
+        return;
+    }
+
+    time_t const limit(time(nullptr) - static_cast<time_t>(f_cache_max_age) * 24 * 60 * 60);
+    for(struct dirent * entry(readdir(dir)); entry != nullptr; entry = readdir(dir))
+    {
+        std::string const name(entry->d_name);
+        if(!is_cache_entry(name))
+        {
+            continue;
+        }
+
+        std::string const path(cache_dir + "/" + name);
+        struct stat st;
+        if(lstat(path.c_str(), &st) == 0
+        && st.st_mtime < limit)
+        {
+            if(f_verbose)
+            {
+                std::cerr << "info: removing unused cache entry \""
+                          << path
+                          << "\"."
+                          << std::endl;
+            }
+            remove_tree(path);
+        }
+    }
+    closedir(dir);
 }
 
 
@@ -20,8 +20,13 @@
 
 
 #include <memory>
+#include <string>
 #include <vector>
 
+// C lib
+//
+#include <sys/types.h>
+
 
 
 namespace lpp
@@ -42,26 +47,65 @@ public:
     void                    set_has_program(bool has_program);
     void                    set_verbosity(bool status);
     void                    set_include_debug(bool status);
+    void                    set_optimization_level(std::string const & level);
+    std::string const &     get_optimization_level() const;
+    void                    set_march_native(bool status);
+    void                    set_lto(bool status);
+    void                    set_static(bool status);
     void                    set_main_cpp(std::string const & path);
     void                    set_output(std::string const & output);
     void                    add_include_path(std::string const & path);
     void                    add_rpath(std::string const & path);
     void                    add_library_path(std::string const & path);
     void                    add_library(std::string const & path);
+    void                    add_source(std::string const & path);
+    void                    set_cache(bool status);
+    void                    set_cache_dir(std::string const & path);
+    void                    set_cache_max_age(std::string const & days);
+    void                    set_jobs(std::string const & count);
 
     int                     compile();
 
 private:
+    struct job_t
+    {
+        std::string         f_source = std::string();
+        std::string         f_object = std::string();
+        std::size_t         f_size = 0;
+    };
+    typedef std::vector<job_t>  job_list_t;
+
+    std::string             get_cache_dir() const;
+    bool                    prepare_precompiled_header(string_list_t const & flags, std::string const & include_path, std::string const & header, string_list_t & pch_flags);
+    bool                    find_object(string_list_t const & flags, std::string const & header, std::string const & object_dir, job_t & job);
+    bool                    compile_objects(string_list_t const & flags, string_list_t const & pch_flags, job_list_t & jobs);
+    std::size_t             get_jobs() const;
+    pid_t                   spawn(string_list_t const & option, int error_fd = -1) const;
+    int                     wait(pid_t pid) const;
+    int                     link(string_list_t const & option) const;
+    void                    prune_cache(std::string const & cache_dir) const;
+
     bool                    f_output_object = false;
     bool                    f_has_program = false;
     bool                    f_verbose = false;
     bool                    f_include_debug = false;
+    std::string             f_optimization_level = std::string("0");
+    bool                    f_march_native = false;
+    bool                    f_lto = false;
+    bool                    f_static = false;
     string_list_t           f_include_paths = string_list_t();
     std::string             f_main_cpp = std::string("/usr/lib/lpp/main.cpp");
     std::string             f_output = std::string();
     string_list_t           f_rpaths = string_list_t();
     string_list_t           f_library_paths = string_list_t();
     string_list_t           f_libraries = string_list_t();
+    string_list_t           f_sources = string_list_t();
+    bool                    f_cache = true;
+    std::string             f_cache_dir = std::string();
+    std::size_t             f_cache_max_age = 30;   // in days, 0 means forever
+    std::size_t             f_jobs = 0;
+    std::size_t             f_reused_objects = 0;
+    std::size_t             f_compiled_objects = 0;
 };
 
 
@@ -30,6 +30,7 @@
 
 // C++ lib
 //
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <sstream>
@@ -229,9 +230,9 @@ void Parser::control_call(control_t & control_info, bool function_call)
         proc_value = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << proc_value
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(procedure_name->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(procedure_name->get_word())
+              << ");\n";
         break;
 
     default:
@@ -272,14 +273,24 @@ void Parser::control_call(control_t & control_info, bool function_call)
           << actual_proc_name
           << "+\"\\\" not found.\");\n"
              "}\n"
-             "lpp::lpp__context::pointer_t "
+             "std::vector<lpp::lpp__thing> "
+          << context_name
+          << "_slots("
+          << proc_info
+          << "->f_slot_count);\n"
+             "lpp::lpp__context "
           << context_name
-          << "(std::make_shared<lpp::lpp__context>(std::string(),"
+          << "(\"\","
           << actual_proc_name
-          << ",0,("
+          << ".c_str(),0,("
+          << proc_info
+          << "->f_flags&lpp::PROCEDURE_FLAG_PRIMITIVE)!=0,"
+          << proc_info
+          << "->f_slot_names,"
+          << context_name
+          << "_slots.data(),"
           << proc_info
-          << "->f_flags&lpp::PROCEDURE_FLAG_PRIMITIVE)!=0"
-             "));\n";
+          << "->f_slot_count);\n";
 
     Token::pointer_t arguments(control_info.f_function_call->get_list_item(1));
     if(arguments->get_token() != token_t::TOK_LIST)
@@ -354,9 +365,9 @@ void Parser::control_call(control_t & control_info, bool function_call)
         case token_t::TOK_THING:
             f_out << "lpp::lpp__value::pointer_t "
                   << arg_var
-                  << "(context->get_thing("
-                  << word_to_cpp_string_literal(arg_value->get_word())
-                  << ")->get_value());\n";
+                  << "("
+                  << get_thing_value(arg_value->get_word())
+                  << ");\n";
             break;
 
         default:
@@ -368,13 +379,13 @@ void Parser::control_call(control_t & control_info, bool function_call)
         }
 
         f_out << context_name
-              << "->set_thing("
-              << word_to_cpp_string_literal(arg_name->get_word())
+              << ".set_thing("
+              << get_atom(arg_name->get_word())
               << ",";
 
         if(arg_direct_value)
         {
-            f_out << "std::make_shared<lpp::lpp__value>("
+            f_out << "lpp::lpp__make_value("
                   << value
                   << ")";
         }
@@ -390,13 +401,13 @@ void Parser::control_call(control_t & control_info, bool function_call)
     //
     //f_out << "lpp::lpp__value::vector_t rest;\n"
     //      << context_name
-    //      << "->set_thing(\"rest\",std::make_shared<lpp::lpp__value>(rest),lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
+    //      << "->set_thing(\"rest\",lpp::lpp__make_value(rest),lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
 
     f_out << context_name
-          << "->attach(context);\n"
+          << ".attach(context);\n"
           << "(*"
           << proc_info
-          << "->f_procedure)("
+          << "->f_procedure)(&"
           << context_name
           << ");\n";
 
@@ -405,7 +416,7 @@ void Parser::control_call(control_t & control_info, bool function_call)
         f_out << control_info.f_result_var
               << "="
               << context_name
-              << "->get_returned_value();\n";
+              << ".get_returned_value();\n";
     }
 
     f_out << "}\n";
@@ -455,9 +466,9 @@ void Parser::control_catch(control_t & control_info)
         tag_value = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << tag_value
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -471,9 +482,14 @@ void Parser::control_catch(control_t & control_info)
     f_out << "try\n"
              "{\n";
 
+    // a call in the try block must stay a call so the errors it
+    // throws get caught
+    //
     Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
     Token::pointer_t instructions(parse_body(instruction_list));
+    ++f_catch_depth;
     output_body(instructions);
+    --f_catch_depth;
 
     f_out << "}\n"
              "catch(lpp::lpp__error const&e)\n"
@@ -539,56 +555,94 @@ void Parser::control_for(control_t & control_info)
         return;
     }
 
-    std::string ctrl_var_name[3];
-    double ctrl_var_value[3]{ 0, 0, 0 };
+    // the start, end and step become C++ numbers; literals and arithmetic
+    // known at compile time keep their type, anything else is converted
+    // to a float at run time
+    //
+    std::string ctrl_value[3];
+    numeric_t ctrl_type[3]{ numeric_t::NUMERIC_NONE, numeric_t::NUMERIC_NONE, numeric_t::NUMERIC_NONE };
     bool direct_value[3]{ false, false, false };
-    bool all_direct(true);
+    double ctrl_var_value[3]{ 0, 0, 0 };
     for(size_t idx(0); idx + 1 < max_ctrl; ++idx)
     {
         Token::pointer_t ctrl_range(arg->get_list_item(idx + 1));
 
         switch(ctrl_range->get_token())
         {
-        case token_t::TOK_FUNCTION_CALL:
-            // the output of a function call will stack a parameter
-            //
-            all_direct = false;
-            ctrl_var_name[idx] = get_unique_name();
-            f_out << "lpp::lpp__value::pointer_t "
-                  << ctrl_var_name[idx]
-                  << ";\n";
-            output_function_call(ctrl_range, ctrl_var_name[idx]);
-            break;
-
         case token_t::TOK_INTEGER:
             direct_value[idx] = true;
             ctrl_var_value[idx] = static_cast<float_t>(ctrl_range->get_integer());
+            ctrl_type[idx] = numeric_t::NUMERIC_INTEGER;
+            ctrl_value[idx] = native_expression(ctrl_range, ctrl_type[idx]);
             break;
 
         case token_t::TOK_FLOAT:
             direct_value[idx] = true;
             ctrl_var_value[idx] = ctrl_range->get_float();
+            ctrl_type[idx] = numeric_t::NUMERIC_FLOAT;
+            ctrl_value[idx] = native_expression(ctrl_range, ctrl_type[idx]);
             break;
 
+        case token_t::TOK_FUNCTION_CALL:
         case token_t::TOK_THING:
-            all_direct = false;
-            ctrl_var_name[idx] = get_unique_name();
-            f_out << "lpp::lpp__value::pointer_t "
-                  << ctrl_var_name[idx]
-                  << "(context->get_thing("
-                  << word_to_cpp_string_literal(ctrl_range->get_word())
-                  << ")->get_value());\n";
+            ctrl_type[idx] = get_numeric_type(ctrl_range);
+            ctrl_value[idx] = get_unique_name();
+            if(ctrl_type[idx] != numeric_t::NUMERIC_NONE)
+            {
+                f_out << (ctrl_type[idx] == numeric_t::NUMERIC_INTEGER ? "lpp::lpp__integer_t " : "lpp::lpp__float_t ")
+                      << ctrl_value[idx]
+                      << "("
+                      << native_expression(ctrl_range, ctrl_type[idx])
+                      << ");\n";
+                break;
+            }
+
+            if(ctrl_range->get_token() == token_t::TOK_THING)
+            {
+                f_out << "lpp::lpp__value::pointer_t "
+                      << ctrl_value[idx]
+                      << "_value("
+                      << get_thing_value(ctrl_range->get_word())
+                      << ");\n";
+            }
+            else
+            {
+                // the output of a function call will stack a parameter
+                //
+                f_out << "lpp::lpp__value::pointer_t "
+                      << ctrl_value[idx]
+                      << "_value;\n";
+                output_function_call(ctrl_range, ctrl_value[idx] + "_value");
+            }
+
+            ctrl_type[idx] = numeric_t::NUMERIC_FLOAT;
+            f_out << "lpp::lpp__float_t "
+                  << ctrl_value[idx]
+                  << "(0);\n"
+                     "switch("
+                  << ctrl_value[idx]
+                  << "_value->type())\n"
+                     "{\n"
+                     "case lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:\n"
+                  << ctrl_value[idx]
+                  << "=static_cast<lpp::lpp__float_t>("
+                  << ctrl_value[idx]
+                  << "_value->get_integer());\n"
+                     "break;\n"
+                     "case lpp::lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:\n"
+                  << ctrl_value[idx]
+                  << "="
+                  << ctrl_value[idx]
+                  << "_value->get_float();\n"
+                     "break;\n"
+                     "default:\n"
+                     "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"for control values must be numbers.\");\n"
+                     "}\n";
             break;
 
         // TODO: support a list as well, although we don't need it in
         //       our Logo so at this point it's not available
         //case token_t::TOK_LIST:
-        //    ctrl_var_name[idx] = get_unique_name();
-        //    f_out << "lpp::lpp__value::pointer_t "
-        //          << ctrl_var_name[idx]
-        //          << ";\n";
-        //    output_function_call(arg, ctrl_var_name[idx]);
-        //    break;
 
         default:
             arg->error("unexpected token type ("
@@ -599,170 +653,305 @@ void Parser::control_for(control_t & control_info)
         }
     }
 
-    std::string const repeat_var(get_unique_name());
-    if(all_direct)
+    if(max_ctrl == 3)
     {
-        // in this one special case, we can generate the for() loop
-        // very easily
+        // the step is 1 or -1 depending on the direction
         //
-        bool growing(true);
-        if(max_ctrl == 3)
+        ctrl_type[2] = numeric_t::NUMERIC_INTEGER;
+        if(direct_value[0] && direct_value[1])
+        {
+            direct_value[2] = true;
+            ctrl_var_value[2] = ctrl_var_value[0] <= ctrl_var_value[1] ? 1.0 : -1.0;
+            ctrl_value[2] = ctrl_var_value[2] >= 0
+                            ? "static_cast<lpp::lpp__integer_t>(1LL)"
+                            : "static_cast<lpp::lpp__integer_t>(-1LL)";
+        }
+        else
+        {
+            ctrl_value[2] = get_unique_name();
+            f_out << "lpp::lpp__integer_t "
+                  << ctrl_value[2]
+                  << "("
+                  << ctrl_value[0]
+                  << "<="
+                  << ctrl_value[1]
+                  << "?1:-1);\n";
+        }
+    }
+
+    // the counter is an integer when it starts on an integer and moves
+    // by an integer; the end bound does not matter
+    //
+    numeric_t const counter_type(ctrl_type[0] == numeric_t::NUMERIC_INTEGER
+                              && ctrl_type[2] == numeric_t::NUMERIC_INTEGER
+                                    ? numeric_t::NUMERIC_INTEGER
+                                    : numeric_t::NUMERIC_FLOAT);
+    char const * const counter_cpp_type(counter_type == numeric_t::NUMERIC_INTEGER
+                                            ? "lpp::lpp__integer_t"
+                                            : "lpp::lpp__float_t");
+    auto to_counter_type = [&](size_t idx)
         {
-            growing = ctrl_var_value[0] <= ctrl_var_value[1];
-            if(growing)
+            if(ctrl_type[idx] != counter_type)
             {
-                ctrl_var_value[2] = 1.0;
+                return "static_cast<lpp::lpp__float_t>(" + ctrl_value[idx] + ")";
             }
-            else
+            return ctrl_value[idx];
+        };
+    auto condition = [&](std::string const & counter)
+        {
+            if(direct_value[2])
             {
-                ctrl_var_value[2] = -1.0;
+                return counter + (ctrl_var_value[2] >= 0 ? "<=" : ">=") + ctrl_value[1];
             }
-        }
-        else if(ctrl_var_value[2] < 0)
-        {
-            growing = false;
-        }
+            return ctrl_value[2]
+                 + ">=0?"
+                 + counter
+                 + "<="
+                 + ctrl_value[1]
+                 + ":"
+                 + counter
+                 + ">="
+                 + ctrl_value[1];
+        };
 
-        f_out << "for(lpp::lpp__float_t "
-              << repeat_var
-              << "("
-              << ctrl_var_value[0]
-              << ");"
-              << repeat_var
-              << (growing ? "<=" : ">=")
-              << ctrl_var_value[1]
-              << ";"
-              << repeat_var
-              << "+="
-              << ctrl_var_value[2]
-              << ")\n"
+    std::string const repeat_var(get_unique_name());
+
+    // the counter is saved in the procedure context, in its slot when it
+    // has one, so the procedures called by the loop can see it
+    //
+    std::string set_counter;
+    std::string const counter_name(var_name->get_word());
+    auto const local_slot(f_local_slots.find(counter_name));
+    if(local_slot != f_local_slots.end())
+    {
+        set_counter = "context->declare_local("
+                    + std::to_string(local_slot->second)
+                    + ",lpp::lpp__make_value("
+                    + repeat_var
+                    + "));\n";
+    }
+    else
+    {
+        set_counter = "context->set_thing("
+                    + get_atom(counter_name)
+                    + ",lpp::lpp__make_value("
+                    + repeat_var
+                    + "),lpp::lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);\n";
+    }
+
+    f_out << counter_cpp_type
+          << " "
+          << repeat_var
+          << "("
+          << to_counter_type(0)
+          << ");\n"
+             "if("
+          << condition(repeat_var)
+          << ")\n"
+             "{\n"
+             "for(;;)\n"
+             "{\n";
+
+    // when nothing in the body can change or search the counter, the
+    // body reads it directly from the C++ loop variable and it only gets
+    // saved once the loop is done (or on each iteration when a NOTIFY
+    // may have to see it)
+    //
+    native_thing_map_t const saved_native_things(f_native_things);
+    bool const native(var_name->get_token() != token_t::TOK_THING
+                   && is_native_counter_safe(control_info.f_function_call->get_list_item(1), counter_name));
+    if(native)
+    {
+        f_native_things[counter_name] = native_thing_t{ repeat_var, counter_type };
+        f_out << "if(context->has_notifications())\n"
                  "{\n"
-                 "lpp::lpp__value::pointer_t "
+              << set_counter
+              << "}\n";
+    }
+    else
+    {
+        f_native_things.erase(counter_name);
+        f_out << set_counter;
+    }
+
+    Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
+    Token::pointer_t instructions(parse_body(instruction_list));
+    output_body(instructions);
+
+    f_native_things = saved_native_things;
+
+    if(counter_type == numeric_t::NUMERIC_INTEGER)
+    {
+        // an end near the limits of lpp__integer_t must stop the loop
+        // instead of overflowing the counter
+        //
+        f_out << "lpp::lpp__integer_t "
               << repeat_var
-              << "_value(std::make_shared<lpp::lpp__value>("
+              << "_next;\n"
+                 "if(__builtin_add_overflow("
               << repeat_var
-              << "));\n"
-                 "context->set_thing("
-              << word_to_cpp_string_literal(var_name->get_word())
               << ","
+              << to_counter_type(2)
+              << ",&"
+              << repeat_var
+              << "_next)\n"
+                 "|| !("
+              << condition(repeat_var + "_next")
+              << "))\n";
+    }
+    else
+    {
+        f_out << "lpp::lpp__float_t const "
               << repeat_var
-              << "_value,lpp::lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);\n";
+              << "_next("
+              << repeat_var
+              << "+"
+              << to_counter_type(2)
+              << ");\n"
+                 "if(!("
+              << condition(repeat_var + "_next")
+              << "))\n";
+    }
+    f_out << "{\n"
+             "break;\n"
+             "}\n"
+          << repeat_var
+          << "="
+          << repeat_var
+          << "_next;\n"
+             "}\n";
 
-        Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
-        Token::pointer_t instructions(parse_body(instruction_list));
-        output_body(instructions);
+    if(native)
+    {
+        f_out << "if(!context->has_notifications())\n"
+                 "{\n"
+              << set_counter
+              << "}\n";
+    }
 
-        f_out << "}\n";
+    f_out << "}\n";
+}
+
+
+/** \brief Check whether a FOR counter can only be seen by its loop.
+ *
+ * The counter is a variable like any other so the instructions of the
+ * loop could modify it or search it by name. This function searches the
+ * instructions for anything that could do so: the name of the counter
+ * itself, variable primitives which do not use a literal name, NAMES,
+ * and calls to user procedures (variables are dynamically scoped).
+ *
+ * The list may already be parsed, in which case the function calls
+ * are TOK_FUNCTION_CALL tokens with their arguments as children.
+ *
+ * \param[in] list  The list of instructions of the loop.
+ * \param[in] name  The name of the counter.
+ *
+ * \return true if the counter can only be seen by the loop.
+ */
+bool Parser::is_native_counter_safe(Token::pointer_t list, std::string const & name)
+{
+    if(list->get_token() != token_t::TOK_LIST
+    && list->get_token() != token_t::TOK_FUNCTION_CALL)
+    {
+        return false;
     }
-    else
+
+    std::size_t const max(list->get_list_size());
+    for(std::size_t idx(0); idx < max; ++idx)
     {
-        for(size_t idx(0); idx + 1 < max_ctrl; ++idx)
+        Token::pointer_t item(list->get_list_item(idx));
+        switch(item->get_token())
         {
-            if(!direct_value[0])
+        case token_t::TOK_LIST:
+            if(!is_native_counter_safe(item, name))
             {
-                f_out << "lpp::lpp__float_t "
-                      << ctrl_var_name[idx]
-                      << "_for(0);\n"
-                         "switch("
-                      << ctrl_var_name[idx]
-                      << "->type())\n"
-                         "{\n"
-                         "case lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER:\n"
-                      << ctrl_var_name[idx]
-                      << "_for=static_cast<lpp::lpp__float_t>("
-                      << ctrl_var_name[idx]
-                      << "->get_integer());\n"
-                         "break;\n"
-                         "case lpp::lpp__value_type_t::LPP__VALUE_TYPE_FLOAT:\n"
-                      << ctrl_var_name[idx]
-                      << "_for="
-                      << ctrl_var_name[idx]
-                      << "->get_float();\n"
-                         "break;\n"
-                         "default:\n"
-                         "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"for control values must be numbers.\");\n"
-                         "}\n";
+                return false;
             }
-        }
+            break;
 
-        if(max_ctrl == 3)
-        {
-            // dynamically determine the step size (1.0 or -1.0)
-            //
-            ctrl_var_name[2] = get_unique_name();
-            f_out << "lpp::lpp__float_t "
-                  << ctrl_var_name[2]
-                  << "_for(";
-            if(direct_value[0])
-            {
-                f_out << direct_value[0];
-            }
-            else
-            {
-                f_out << ctrl_var_name[0]
-                      << "_for";
-            }
-            f_out << "<=";
-            if(direct_value[1])
+        case token_t::TOK_QUOTED:
+            if(item->get_word() == name)
             {
-                f_out << direct_value[1];
+                return false;
             }
-            else
+            break;
+
+        case token_t::TOK_WORD:
+        case token_t::TOK_FUNCTION_CALL:
             {
-                f_out << ctrl_var_name[1]
-                      << "_for";
+                std::string const & word(item->get_word());
+                if(word == name)
+                {
+                    return false;
+                }
+                Token::pointer_t declaration(f_declarations->get_map_item(word));
+                if(declaration == nullptr)
+                {
+                    break;
+                }
+                if((declaration->get_procedure_flags() & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PRIMITIVE)
+                {
+                    return false;
+                }
+                std::string const & primitive(declaration->get_word());
+                if(primitive == "make"
+                || primitive == "localmake"
+                || primitive == "local"
+                || primitive == "push"
+                || primitive == "pop"
+                || primitive == "queue"
+                || primitive == "dequeue"
+                || primitive == "thing"
+                || primitive == "namep")
+                {
+                    // the variable name must be a literal; it is the
+                    // first argument of a parsed call, otherwise the
+                    // next item of the list
+                    //
+                    Token::pointer_t var;
+                    if(item->get_token() == token_t::TOK_FUNCTION_CALL)
+                    {
+                        if(item->get_list_size() > 0)
+                        {
+                            var = item->get_list_item(0);
+                        }
+                    }
+                    else if(idx + 1 < max)
+                    {
+                        var = list->get_list_item(idx + 1);
+                    }
+                    if(var == nullptr
+                    || (var->get_token() != token_t::TOK_QUOTED
+                        && var->get_token() != token_t::TOK_LIST))
+                    {
+                        return false;
+                    }
+                }
+                else if(primitive == "name"
+                     || primitive == "names"
+                     || primitive == "call"
+                     || primitive == "callfunction"
+                     || primitive == "erase"
+                     || primitive == "notify")
+                {
+                    return false;
+                }
+                if(item->get_token() == token_t::TOK_FUNCTION_CALL
+                && !is_native_counter_safe(item, name))
+                {
+                    return false;
+                }
             }
-            f_out << "?1.0:-1.0);\n";
-        }
+            break;
 
-        f_out << "for(lpp::lpp__float_t "
-              << repeat_var
-              << "("
-              << (direct_value[0] ? std::to_string(ctrl_var_value[0]) : ctrl_var_name[0] + "_for")
-              << ");";
+        default:
+            break;
 
-        if(direct_value[2])
-        {
-            f_out << repeat_var
-                  << (ctrl_var_value[2] >= 0 ? "<=" : ">=")
-                  << (direct_value[1] ? std::to_string(ctrl_var_value[1]) : ctrl_var_name[1] + "_for");
         }
-        else
-        {
-            f_out << ctrl_var_name[2]
-                  << "_for>=0?"
-                  << repeat_var
-                  << "<="
-                  << (direct_value[1] ? std::to_string(ctrl_var_value[1]) : ctrl_var_name[1] + "_for")
-                  << ":"
-                  << repeat_var
-                  << ">="
-                  << (direct_value[1] ? std::to_string(ctrl_var_value[1]) : ctrl_var_name[1] + "_for");
-        }
-
-        f_out << ";"
-              << repeat_var
-              << "+="
-              << (direct_value[2] ? std::to_string(ctrl_var_value[2]) : ctrl_var_name[2] + "_for")
-              << ")\n"
-                 "{\n"
-                 "lpp::lpp__value::pointer_t "
-              << repeat_var
-              << "_value(std::make_shared<lpp::lpp__value>("
-              << repeat_var
-              << "));\n"
-                 "context->set_thing("
-              << word_to_cpp_string_literal(var_name->get_word())
-              << ","
-              << repeat_var
-              << "_value,lpp::lpp__thing_type_t::LPP__THING_TYPE_PROCEDURE);\n";
-
-        Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
-        Token::pointer_t instructions(parse_body(instruction_list));
-        output_body(instructions);
-
-        f_out << "}\n";
     }
+
+    return true;
 }
 
 
@@ -842,6 +1031,7 @@ void Parser::control_if(control_t & control_info, bool always_else)
     }
 
     std::string value_name;
+    std::string condition;
     Token::pointer_t arg(control_info.f_function_call->get_list_item(0));
 
     bool direct_value(false);
@@ -850,6 +1040,14 @@ void Parser::control_if(control_t & control_info, bool always_else)
     switch(arg->get_token())
     {
     case token_t::TOK_FUNCTION_CALL:
+        // predicates directly give us a C++ bool
+        //
+        if(is_native_boolean(arg))
+        {
+            condition = output_boolean(arg);
+            break;
+        }
+
         // the output of a function call will stack a parameter
         //
         value_name = get_unique_name();
@@ -868,9 +1066,9 @@ void Parser::control_if(control_t & control_info, bool always_else)
         value_name = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -887,46 +1085,49 @@ void Parser::control_if(control_t & control_info, bool always_else)
         {
             Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
             Token::pointer_t instructions(parse_body(instruction_list));
-            output_body(instructions);
+            output_body(instructions, control_info.f_tail_position);
         }
         else if(control_info.f_max_args == 3)
         {
             Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(2));
             Token::pointer_t instructions(parse_body(instruction_list));
-            output_body(instructions);
+            output_body(instructions, control_info.f_tail_position);
         }
         // else -- nothing
     }
     else
     {
-        std::string const tf_var(get_unique_name());
-        f_out << "bool "
-              << tf_var
-              << ";\n"
-                 "if("
-              << value_name
-              << "->type()"
-                 "=="
-                 "lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)\n"
-                 "{\n"
-              << tf_var
-              << "="
-              << value_name
-              << "->get_boolean();\n"
-                 "}\n"
-                 "else\n"
-                 "{\n"
-                 "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"if expression must be a boolean.\");\n"
-                 "}\n"
-                 "if("
-              << tf_var
+        if(condition.empty())
+        {
+            condition = get_unique_name();
+            f_out << "bool "
+                  << condition
+                  << ";\n"
+                     "if("
+                  << value_name
+                  << "->type()"
+                     "=="
+                     "lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)\n"
+                     "{\n"
+                  << condition
+                  << "="
+                  << value_name
+                  << "->get_boolean();\n"
+                     "}\n"
+                     "else\n"
+                     "{\n"
+                     "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"if expression must be a boolean.\");\n"
+                     "}\n";
+        }
+        f_out << "if("
+              << condition
               << ")\n"
               << "{\n";
 
         {
             Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(1));
             Token::pointer_t instructions(parse_body(instruction_list));
-            output_body(instructions);
+            output_body(instructions, control_info.f_tail_position);
         }
 
         f_out << "}\n";
@@ -938,7 +1139,7 @@ void Parser::control_if(control_t & control_info, bool always_else)
 
             Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(2));
             Token::pointer_t instructions(parse_body(instruction_list));
-            output_body(instructions);
+            output_body(instructions, control_info.f_tail_position);
 
             f_out << "}\n";
         }
@@ -960,7 +1161,7 @@ void Parser::control_if_test(control_t & control_info, bool true_or_false)
 
     Token::pointer_t instruction_list(control_info.f_function_call->get_list_item(0));
     Token::pointer_t instructions(parse_body(instruction_list));
-    output_body(instructions);
+    output_body(instructions, control_info.f_tail_position);
 
     f_out << "}\n";
 }
@@ -968,11 +1169,13 @@ void Parser::control_if_test(control_t & control_info, bool true_or_false)
 
 void Parser::control_output(control_t & control_info)
 {
+    // OUTPUT returns right after computing its value so a call to
+    // the procedure itself can become a jump
+    //
     std::string const value_name(get_unique_name());
+    f_tail_position = f_tail_calls && f_catch_depth == 0;
     output_argument(control_info.f_function_call->get_list_item(0), value_name);
-    f_out << "context->set_return_value("
-          << value_name
-          << ");\n";
+    f_tail_position = false;
 
     if(f_enable_trace)
     {
@@ -981,7 +1184,22 @@ void Parser::control_output(control_t & control_info)
               << ");\n";
     }
 
-    f_out << "return;\n";
+    // procedures return their value to the caller; the program has
+    // no caller
+    //
+    if(f_function != nullptr)
+    {
+        f_out << "return "
+              << value_name
+              << ";\n";
+    }
+    else
+    {
+        f_out << "context->set_return_value("
+              << value_name
+              << ");\n"
+                 "return;\n";
+    }
 }
 
 
@@ -1024,9 +1242,9 @@ void Parser::control_repeat(control_t & control_info)
         value_name = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -1113,7 +1331,14 @@ void Parser::control_stop(control_t & control_info)
         f_out << "context->trace_procedure(lpp::trace_mode_t::TRACE_MODE_STOP,lpp::lpp__value::pointer_t());\n";
     }
 
-    f_out << "return;\n";
+    if(f_function != nullptr)
+    {
+        f_out << "return lpp::lpp__value::pointer_t();\n";
+    }
+    else
+    {
+        f_out << "return;\n";
+    }
 }
 
 
@@ -1185,9 +1410,9 @@ void Parser::control_throw(control_t & control_info)
         tag_value = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << tag_value
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -1247,6 +1472,7 @@ void Parser::control_while(control_t & control_info, bool until, bool once)
     }
 
     std::string value_name;
+    std::string condition;
     Token::pointer_t arg(control_info.f_function_call->get_list_item(0));
 
     bool direct_value(false);
@@ -1268,6 +1494,14 @@ void Parser::control_while(control_t & control_info, bool until, bool once)
             output_body(instructions);
         }
 
+        // predicates directly give us a C++ bool
+        //
+        if(is_native_boolean(arg))
+        {
+            condition = output_boolean(arg);
+            break;
+        }
+
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
               << ";\n";
@@ -1293,9 +1527,9 @@ void Parser::control_while(control_t & control_info, bool until, bool once)
 
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -1328,28 +1562,31 @@ void Parser::control_while(control_t & control_info, bool until, bool once)
     }
     else
     {
-        std::string const tf_var(get_unique_name());
-        f_out << "bool "
-              << tf_var
-              << ";\n"
-                 "if("
-              << value_name
-              << "->type()"
-                 "=="
-                 "lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)\n"
-                 "{\n"
-              << tf_var
-              << "="
-              << value_name
-              << "->get_boolean();\n"
-                 "}\n"
-                 "else\n"
-                 "{\n"
-                 "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"if expression must be a boolean.\");\n"
-                 "}\n"
-                 "if("
+        if(condition.empty())
+        {
+            condition = get_unique_name();
+            f_out << "bool "
+                  << condition
+                  << ";\n"
+                     "if("
+                  << value_name
+                  << "->type()"
+                     "=="
+                     "lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN)\n"
+                     "{\n"
+                  << condition
+                  << "="
+                  << value_name
+                  << "->get_boolean();\n"
+                     "}\n"
+                     "else\n"
+                     "{\n"
+                     "throw lpp::lpp__error(context,lpp::lpp__error_code_t::ERROR_CODE_INVALID_DATUM,\"error\",\"if expression must be a boolean.\");\n"
+                     "}\n";
+        }
+        f_out << "if("
               << (until ? "" : "!")
-              << tf_var
+              << condition
               << ")\n"
                  "{\n"
                  "break;\n"
@@ -30,6 +30,7 @@
 
 // C++ lib
 //
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <sstream>
@@ -50,10 +51,149 @@ bool Parser::inline_primitive(control_t & control_info)
         return false;
     }
 
-    std::string const name(control_info.f_function_call->get_word());
+    // the declaration has the name even when the call uses an alias
+    //
+    std::string const name(control_info.f_declaration->get_word());
 
     switch(name[0])
     {
+    case 'a':
+        if(name == "and")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    case 'b':
+        if(name == "butfirst")
+        {
+            return primitive_butfirst(control_info);
+        }
+        break;
+
+    case 'c':
+        if(name == "count")
+        {
+            return primitive_count(control_info);
+        }
+        break;
+
+    case 'd':
+        if(name == "difference")
+        {
+            return primitive_arithmetic(control_info);
+        }
+        break;
+
+    case 'e':
+        if(name == "emptyp"
+        || name == "equalp")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    case 'f':
+        if(name == "first")
+        {
+            return primitive_first(control_info, false);
+        }
+        if(name == "fput")
+        {
+            return primitive_put(control_info, false);
+        }
+        break;
+
+    case 'g':
+        if(name == "greaterp")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    case 'i':
+        if(name == "item")
+        {
+            return primitive_item(control_info);
+        }
+        break;
+
+    case 'l':
+        if(name == "last")
+        {
+            return primitive_first(control_info, true);
+        }
+        if(name == "lessp"
+        || name == "listp")
+        {
+            return primitive_predicate(control_info);
+        }
+        if(name == "local")
+        {
+            return primitive_local(control_info);
+        }
+        if(name == "localmake")
+        {
+            return primitive_make(control_info, 0, true);
+        }
+        if(name == "lput")
+        {
+            return primitive_put(control_info, true);
+        }
+        break;
+
+    case 'm':
+        if(name == "make")
+        {
+            return primitive_make(control_info, 0, false);
+        }
+        if(name == "minus")
+        {
+            return primitive_arithmetic(control_info);
+        }
+        break;
+
+    case 'n':
+        if(name == "name")
+        {
+            return primitive_make(control_info, 1, false);
+        }
+        if(name == "not"
+        || name == "numberp")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    case 'o':
+        if(name == "or")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    case 'p':
+        if(name == "plus"
+        || name == "product")
+        {
+            return primitive_arithmetic(control_info);
+        }
+        break;
+
+    case 'q':
+        if(name == "quotient")
+        {
+            return primitive_arithmetic(control_info);
+        }
+        break;
+
+    case 's':
+        if(name == "sum")
+        {
+            return primitive_arithmetic(control_info);
+        }
+        break;
+
     case 't':
         if(name == "thing")
         {
@@ -68,18 +208,853 @@ bool Parser::inline_primitive(control_t & control_info)
             primitive_wait(control_info);
             return true;
         }
+        if(name == "wordp")
+        {
+            return primitive_predicate(control_info);
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+    return false;
+}
+
+
+
+
+
+/** \brief Compute an arithmetic expression with C++ numbers.
+ *
+ * When all the operands of SUM, DIFFERENCE, PRODUCT, QUOTIENT, MINUS
+ * and PLUS are known to be numbers at compile time, the whole expression
+ * is computed with lpp__integer_t and lpp__float_t and only the final
+ * result gets saved in an lpp__value. Otherwise the function returns
+ * false and the primitive gets called.
+ *
+ * The integer operations are checked: a result which does not fit in
+ * an lpp__integer_t raises an arithmetic error instead of wrapping.
+ *
+ * \param[in] control_info  The arithmetic function call.
+ *
+ * \return true if the expression was generated inline.
+ */
+bool Parser::primitive_arithmetic(control_t & control_info)
+{
+    numeric_t const type(get_numeric_type(control_info.f_function_call));
+    if(type == numeric_t::NUMERIC_NONE)
+    {
+        return false;
+    }
+
+    std::string const expr(native_expression(control_info.f_function_call, type));
+    if(control_info.f_result_var.empty())
+    {
+        f_out << "static_cast<void>("
+              << expr
+              << ");\n";
+    }
+    else
+    {
+        f_out << control_info.f_result_var
+              << "=lpp::lpp__number::to_value("
+              << expr
+              << ");\n";
+    }
+
+    return true;
+}
+
+
+/** \brief Determine the numeric type of an expression.
+ *
+ * Literal numbers, FOR counters and the results of the basic arithmetic
+ * primitives applied to such are numbers known at compile time. Anything
+ * else (variables, other functions, words...) is only known at run time
+ * and makes the function return NUMERIC_NONE.
+ *
+ * \param[in] expr  The expression to check.
+ *
+ * \return The type of the expression or NUMERIC_NONE.
+ */
+numeric_t Parser::get_numeric_type(Token::pointer_t expr)
+{
+    switch(expr->get_token())
+    {
+    case token_t::TOK_INTEGER:
+        return numeric_t::NUMERIC_INTEGER;
+
+    case token_t::TOK_FLOAT:
+        return numeric_t::NUMERIC_FLOAT;
+
+    case token_t::TOK_THING:
+        {
+            auto const it(f_native_things.find(expr->get_word()));
+            if(it != f_native_things.end())
+            {
+                return it->second.f_type;
+            }
+        }
+        return numeric_t::NUMERIC_NONE;
+
+    case token_t::TOK_FUNCTION_CALL:
+        break;
+
+    default:
+        return numeric_t::NUMERIC_NONE;
+
+    }
+
+    Token::pointer_t declaration(expr->get_declaration());
+    if(declaration == nullptr
+    || (declaration->get_procedure_flags() & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PRIMITIVE)
+    {
+        return numeric_t::NUMERIC_NONE;
+    }
+
+    std::string const & name(declaration->get_word());
+    if(name == "minus"
+    || name == "plus")
+    {
+        if(expr->get_list_size() != 1)
+        {
+            return numeric_t::NUMERIC_NONE;
+        }
+        return get_numeric_type(expr->get_list_item(0));
+    }
+
+    if(name != "sum"
+    && name != "difference"
+    && name != "product"
+    && name != "quotient")
+    {
+        return numeric_t::NUMERIC_NONE;
+    }
+
+    if(expr->get_list_size() != 2)
+    {
+        return numeric_t::NUMERIC_NONE;
+    }
+
+    numeric_t const lhs(get_numeric_type(expr->get_list_item(0)));
+    numeric_t const rhs(get_numeric_type(expr->get_list_item(1)));
+    if(lhs == numeric_t::NUMERIC_NONE
+    || rhs == numeric_t::NUMERIC_NONE)
+    {
+        return numeric_t::NUMERIC_NONE;
+    }
+
+    // like lpp__number::compute(), QUOTIENT always divides floats
+    //
+    if(name == "quotient"
+    || lhs == numeric_t::NUMERIC_FLOAT
+    || rhs == numeric_t::NUMERIC_FLOAT)
+    {
+        return numeric_t::NUMERIC_FLOAT;
+    }
+
+    return numeric_t::NUMERIC_INTEGER;
+}
+
+
+/** \brief Generate the C++ expression of a numeric expression.
+ *
+ * The \p expr parameter must be an expression for which
+ * get_numeric_type() returned a type other than NUMERIC_NONE.
+ *
+ * \param[in] expr  The expression to convert.
+ * \param[in] type  The type the C++ expression has to have.
+ *
+ * \return The C++ expression.
+ */
+std::string Parser::native_expression(Token::pointer_t expr, numeric_t type)
+{
+    numeric_t const expr_type(get_numeric_type(expr));
+    std::string result;
+
+    switch(expr->get_token())
+    {
+    case token_t::TOK_INTEGER:
+        if(expr->get_integer() == std::numeric_limits<integer_t>::min())
+        {
+            // the literal would be the negation of a too large number
+            //
+            result = "std::numeric_limits<lpp::lpp__integer_t>::min()";
+        }
+        else
+        {
+            result = "static_cast<lpp::lpp__integer_t>(" + std::to_string(expr->get_integer()) + "LL)";
+        }
+        if(type == numeric_t::NUMERIC_FLOAT)
+        {
+            return "static_cast<lpp::lpp__float_t>(" + result + ")";
+        }
+        return result;
+
+    case token_t::TOK_FLOAT:
+        {
+            float_t const value(expr->get_float());
+            if(std::isnan(value))
+            {
+                return "std::numeric_limits<lpp::lpp__float_t>::quiet_NaN()";
+            }
+            if(std::isinf(value))
+            {
+                return value < 0.0
+                        ? "-std::numeric_limits<lpp::lpp__float_t>::infinity()"
+                        : "std::numeric_limits<lpp::lpp__float_t>::infinity()";
+            }
+            std::stringstream ss;
+            ss.precision(std::numeric_limits<float_t>::max_digits10);
+            ss << value;
+            return "static_cast<lpp::lpp__float_t>(" + ss.str() + ")";
+        }
+
+    case token_t::TOK_THING:
+        result = f_native_things[expr->get_word()].f_expression;
         break;
 
     default:
+        {
+            std::string const & name(expr->get_declaration()->get_word());
+            if(name == "minus")
+            {
+                if(expr_type == numeric_t::NUMERIC_INTEGER)
+                {
+                    result = "lpp::lpp__number::negate(context," + native_expression(expr->get_list_item(0), expr_type) + ")";
+                }
+                else
+                {
+                    result = "(-" + native_expression(expr->get_list_item(0), expr_type) + ")";
+                }
+            }
+            else if(name == "plus")
+            {
+                result = native_expression(expr->get_list_item(0), expr_type);
+            }
+            else
+            {
+                std::string const lhs(native_expression(expr->get_list_item(0), expr_type));
+                std::string const rhs(native_expression(expr->get_list_item(1), expr_type));
+                if(name == "quotient")
+                {
+                    // the division checks for a zero divisor
+                    //
+                    result = "lpp::lpp__number::divide(context," + lhs + "," + rhs + ")";
+                }
+                else if(expr_type == numeric_t::NUMERIC_INTEGER)
+                {
+                    // the integers must not silently overflow
+                    //
+                    char const * const op(name == "sum" ? "add" : (name == "difference" ? "subtract" : "multiply"));
+                    result = std::string("lpp::lpp__number::") + op + "(context," + lhs + "," + rhs + ")";
+                }
+                else
+                {
+                    char const op(name == "sum" ? '+' : (name == "difference" ? '-' : '*'));
+                    result = "(" + lhs + op + rhs + ")";
+                }
+            }
+        }
         break;
 
     }
 
+    if(type != expr_type)
+    {
+        return "static_cast<lpp::lpp__float_t>(" + result + ")";
+    }
+
+    return result;
+}
+
+
+/** \brief Check whether an expression can be computed as a C++ bool.
+ *
+ * The predicates EMPTYP, LISTP, NUMBERP and WORDP, the comparisons
+ * EQUALP, LESSP and GREATERP of two values and the logical functions
+ * NOT, AND and OR of one or two values always produce a boolean, so
+ * output_boolean() computes them without creating an lpp__value.
+ *
+ * \param[in] expr  The expression to check.
+ *
+ * \return true if output_boolean() can be used with \p expr.
+ */
+bool Parser::is_native_boolean(Token::pointer_t expr)
+{
+    switch(expr->get_token())
+    {
+    case token_t::TOK_BOOLEAN:
+        return true;
+
+    case token_t::TOK_FUNCTION_CALL:
+        break;
+
+    default:
+        return false;
+
+    }
+
+    Token::pointer_t declaration(expr->get_declaration());
+    if(declaration == nullptr
+    || (declaration->get_procedure_flags() & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PRIMITIVE)
+    {
+        return false;
+    }
+
+    std::string const & name(declaration->get_word());
+    if(name == "emptyp"
+    || name == "listp"
+    || name == "not"
+    || name == "numberp"
+    || name == "wordp")
+    {
+        return expr->get_list_size() == 1;
+    }
+
+    // with a :REST the primitive is called
+    //
+    if(name == "and"
+    || name == "equalp"
+    || name == "greaterp"
+    || name == "lessp"
+    || name == "or")
+    {
+        return expr->get_list_size() == 2;
+    }
+
     return false;
 }
 
 
+/** \brief Generate the C++ bool expression of a predicate.
+ *
+ * The \p expr parameter must be an expression for which
+ * is_native_boolean() returned true.
+ *
+ * The arguments get computed first so the function may write statements
+ * before returning the expression. When the value given to NOT, AND or
+ * OR is not a boolean, the primitive gets called to raise the error.
+ *
+ * \param[in] expr  The expression to convert.
+ *
+ * \return The C++ expression.
+ */
+std::string Parser::output_boolean(Token::pointer_t expr)
+{
+    if(expr->get_token() == token_t::TOK_BOOLEAN)
+    {
+        return expr->get_boolean() ? "true" : "false";
+    }
+
+    std::string const & name(expr->get_declaration()->get_word());
+    if(name == "equalp"
+    || name == "greaterp"
+    || name == "lessp")
+    {
+        Token::pointer_t lhs(expr->get_list_item(0));
+        Token::pointer_t rhs(expr->get_list_item(1));
+        if(get_numeric_type(lhs) == numeric_t::NUMERIC_INTEGER
+        && get_numeric_type(rhs) == numeric_t::NUMERIC_INTEGER)
+        {
+            char const * op(name == "equalp" ? "==" : (name == "lessp" ? "<" : ">"));
+            return "("
+                 + native_expression(lhs, numeric_t::NUMERIC_INTEGER)
+                 + op
+                 + native_expression(rhs, numeric_t::NUMERIC_INTEGER)
+                 + ")";
+        }
+
+        std::string const lhs_name(get_unique_name());
+        std::string const rhs_name(get_unique_name());
+        output_argument(lhs, lhs_name);
+        output_argument(rhs, rhs_name);
+
+        char const * compare(name == "equalp" ? "0" : (name == "lessp" ? "-1" : "1"));
+        return "(lpp::lpp__number::compare_values(context,"
+             + lhs_name
+             + ","
+             + rhs_name
+             + ",false)=="
+             + compare
+             + ")";
+    }
+
+    if(name == "and"
+    || name == "not"
+    || name == "or")
+    {
+        string_list_t values;
+        string_list_t booleans;
+        std::string check;
+        for(Token::vector_t::size_type idx(0); idx < expr->get_list_size(); ++idx)
+        {
+            Token::pointer_t arg(expr->get_list_item(idx));
+            if(is_native_boolean(arg))
+            {
+                std::string const b(output_boolean(arg));
+                booleans.push_back(b);
+                values.push_back("lpp::lpp__make_value(" + b + ")");
+            }
+            else
+            {
+                std::string const value_name(get_unique_name());
+                output_argument(arg, value_name);
+                booleans.push_back(value_name + "->get_boolean()");
+                values.push_back(value_name);
+                if(!check.empty())
+                {
+                    check += "||";
+                }
+                check += value_name + "->type()!=lpp::lpp__value_type_t::LPP__VALUE_TYPE_BOOLEAN";
+            }
+        }
+        if(!check.empty())
+        {
+            f_out << "if("
+                  << check
+                  << ")\n"
+                     "{\n";
+            output_primitive_call(expr, values, std::string());
+            f_out << "}\n";
+        }
+
+        if(name == "not")
+        {
+            return "(!" + booleans[0] + ")";
+        }
+        return "("
+             + booleans[0]
+             + (name == "and" ? "&&" : "||")
+             + booleans[1]
+             + ")";
+    }
+
+    std::string const value_name(get_unique_name());
+    output_argument(expr->get_list_item(0), value_name);
+
+    if(name == "emptyp")
+    {
+        return "(("
+             + value_name
+             + "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD&&"
+             + value_name
+             + "->get_word().empty())||("
+             + value_name
+             + "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST&&"
+             + value_name
+             + "->get_list().empty()))";
+    }
+    if(name == "listp")
+    {
+        return "("
+             + value_name
+             + "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)";
+    }
+    if(name == "numberp")
+    {
+        return value_name + "->represents_float()";
+    }
+    if(name == "wordp")
+    {
+        return value_name + "->represents_word()";
+    }
+
+    throw std::logic_error("output_boolean() called with unsupported primitive \"" + name + "\".");
+}
+
+
+/** \brief Compute a predicate with a C++ bool.
+ *
+ * Only the final result of the predicate gets saved in an lpp__value.
+ *
+ * \param[in] control_info  The predicate function call.
+ *
+ * \return true if the predicate was generated inline.
+ */
+bool Parser::primitive_predicate(control_t & control_info)
+{
+    if(control_info.f_result_var.empty()
+    || !is_native_boolean(control_info.f_function_call))
+    {
+        return false;
+    }
+
+    f_out << "{\n";
+    std::string const expr(output_boolean(control_info.f_function_call));
+    f_out << control_info.f_result_var
+          << "=lpp::lpp__make_value("
+          << expr
+          << ");\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Get the first or last item of a list inline.
+ *
+ * Words, empty lists and other values are handled by calling the
+ * primitive.
+ *
+ * \param[in] control_info  The FIRST or LAST function call.
+ * \param[in] last  Whether the last item is wanted.
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_first(control_t & control_info, bool last)
+{
+    if(control_info.f_max_args != 1)
+    {
+        throw std::logic_error(std::string("primitive \"")
+                             + (last ? "last" : "first")
+                             + "\" called with a number of parameters not equal to 1.");
+    }
+    if(control_info.f_result_var.empty())
+    {
+        return false;
+    }
+
+    std::string const thing_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(0), thing_name);
+    f_out << "if("
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST\n"
+             "&&!"
+          << thing_name
+          << "->get_list().empty())\n"
+             "{\n"
+          << control_info.f_result_var
+          << "="
+          << thing_name
+          << "->get_list()."
+          << (last ? "back" : "front")
+          << "();\n"
+             "}\n"
+             "else\n"
+             "{\n";
+    output_primitive_call(control_info.f_function_call, { thing_name }, control_info.f_result_var);
+    f_out << "}\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Remove the first item of a list inline.
+ *
+ * The new list shares its items with the input list. Words, empty
+ * lists and other values are handled by calling the primitive.
+ *
+ * \param[in] control_info  The BUTFIRST function call.
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_butfirst(control_t & control_info)
+{
+    if(control_info.f_max_args != 1)
+    {
+        throw std::logic_error("primitive \"butfirst\" called with a number of parameters not equal to 1.");
+    }
+    if(control_info.f_result_var.empty())
+    {
+        return false;
+    }
+
+    std::string const thing_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(0), thing_name);
+    f_out << "if("
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST\n"
+             "&&!"
+          << thing_name
+          << "->get_list().empty())\n"
+             "{\n"
+          << control_info.f_result_var
+          << "=lpp::lpp__make_value("
+          << thing_name
+          << "->get_list().butfirst());\n"
+             "}\n"
+             "else\n"
+             "{\n";
+    output_primitive_call(control_info.f_function_call, { thing_name }, control_info.f_result_var);
+    f_out << "}\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Count the items of a list or the characters of a word inline.
+ *
+ * Numbers and booleans are handled by calling the primitive.
+ *
+ * \param[in] control_info  The COUNT function call.
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_count(control_t & control_info)
+{
+    if(control_info.f_max_args != 1)
+    {
+        throw std::logic_error("primitive \"count\" called with a number of parameters not equal to 1.");
+    }
+    if(control_info.f_result_var.empty())
+    {
+        return false;
+    }
+
+    std::string const thing_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(0), thing_name);
+    f_out << "if("
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)\n"
+             "{\n"
+          << control_info.f_result_var
+          << "=lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>("
+          << thing_name
+          << "->get_list().size()));\n"
+             "}\n"
+             "else if("
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_WORD)\n"
+             "{\n"
+          << control_info.f_result_var
+          << "=lpp::lpp__make_value(static_cast<lpp::lpp__integer_t>("
+          << thing_name
+          << "->get_word().length()));\n"
+             "}\n"
+             "else\n"
+             "{\n";
+    output_primitive_call(control_info.f_function_call, { thing_name }, control_info.f_result_var);
+    f_out << "}\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Get an item of a list inline.
+ *
+ * The position has to be an integer within the list. Anything else,
+ * errors included, is handled by calling the primitive.
+ *
+ * \param[in] control_info  The ITEM function call.
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_item(control_t & control_info)
+{
+    if(control_info.f_max_args != 2)
+    {
+        throw std::logic_error("primitive \"item\" called with a number of parameters not equal to 2.");
+    }
+    if(control_info.f_result_var.empty())
+    {
+        return false;
+    }
+
+    std::string const number_name(get_unique_name());
+    std::string const thing_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(0), number_name);
+    output_argument(control_info.f_function_call->get_list_item(1), thing_name);
+    f_out << "if("
+          << number_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_INTEGER\n"
+             "&&"
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST\n"
+             "&&"
+          << number_name
+          << "->get_integer()>0\n"
+             "&&static_cast<std::size_t>("
+          << number_name
+          << "->get_integer())<="
+          << thing_name
+          << "->get_list().size())\n"
+             "{\n"
+          << control_info.f_result_var
+          << "="
+          << thing_name
+          << "->get_list()["
+          << number_name
+          << "->get_integer()-1];\n"
+             "}\n"
+             "else\n"
+             "{\n";
+    output_primitive_call(control_info.f_function_call, { number_name, thing_name }, control_info.f_result_var);
+    f_out << "}\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Add an item in front or at the end of a list inline.
+ *
+ * Words and other values are handled by calling the primitive.
+ *
+ * \param[in] control_info  The FPUT or LPUT function call.
+ * \param[in] last  Whether the item is added at the end (LPUT).
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_put(control_t & control_info, bool last)
+{
+    if(control_info.f_max_args != 2)
+    {
+        throw std::logic_error(std::string("primitive \"")
+                             + (last ? "lput" : "fput")
+                             + "\" called with a number of parameters not equal to 2.");
+    }
+    if(control_info.f_result_var.empty())
+    {
+        return false;
+    }
 
+    std::string const item_name(get_unique_name());
+    std::string const thing_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(0), item_name);
+    output_argument(control_info.f_function_call->get_list_item(1), thing_name);
+    f_out << "if("
+          << thing_name
+          << "->type()==lpp::lpp__value_type_t::LPP__VALUE_TYPE_LIST)\n"
+             "{\n"
+          << control_info.f_result_var
+          << "=lpp::lpp__make_value("
+          << thing_name
+          << "->get_list()."
+          << (last ? "lput" : "fput")
+          << "("
+          << item_name
+          << "));\n"
+             "}\n"
+             "else\n"
+             "{\n";
+    output_primitive_call(control_info.f_function_call, { item_name, thing_name }, control_info.f_result_var);
+    f_out << "}\n"
+             "}\n";
+
+    return true;
+}
+
+
+/** \brief Declare local variables directly in their slot.
+ *
+ * When all the names of a LOCAL command are literal words which were
+ * given a local slot, the declaration is done inline. Otherwise the
+ * function returns false and the primitive gets called.
+ *
+ * \param[in] control_info  The LOCAL function call.
+ *
+ * \return true if the LOCAL was generated inline.
+ */
+bool Parser::primitive_local(control_t & control_info)
+{
+    std::vector<std::size_t> slots;
+    for(Token::vector_t::size_type idx(0); idx < control_info.f_max_args; ++idx)
+    {
+        Token::pointer_t arg(control_info.f_function_call->get_list_item(idx));
+        Token::vector_t::size_type const max(arg->get_token() == token_t::TOK_LIST ? arg->get_list_size() : 1);
+        for(Token::vector_t::size_type l(0); l < max; ++l)
+        {
+            Token::pointer_t name(arg->get_token() == token_t::TOK_LIST ? arg->get_list_item(l) : arg);
+            if(name->get_token() != token_t::TOK_QUOTED
+            && (name->get_token() != token_t::TOK_WORD || arg->get_token() != token_t::TOK_LIST))
+            {
+                return false;
+            }
+            auto const it(f_local_slots.find(name->get_word()));
+            if(it == f_local_slots.end())
+            {
+                return false;
+            }
+            slots.push_back(it->second);
+        }
+    }
+
+    for(auto const idx : slots)
+    {
+        f_out << "context->declare_local("
+              << idx
+              << ");\n";
+    }
+
+    return true;
+}
+
+
+/** \brief Set a parameter or a local variable directly in its slot.
+ *
+ * This function handles MAKE, NAME and LOCALMAKE when the name of the
+ * variable is a literal word which was given a slot. Otherwise the
+ * function returns false and the primitive gets called.
+ *
+ * \param[in] control_info  The function call.
+ * \param[in] name_idx  The position of the variable name in the call.
+ * \param[in] local  Whether the variable gets declared (LOCALMAKE).
+ *
+ * \return true if the function call was generated inline.
+ */
+bool Parser::primitive_make(control_t & control_info, int name_idx, bool local)
+{
+    if(control_info.f_max_args != 2)
+    {
+        throw std::logic_error("primitive \""
+                             + control_info.f_function_call->get_word()
+                             + "\" called with a number of parameters not equal to 2.");
+    }
+
+    Token::pointer_t name(control_info.f_function_call->get_list_item(name_idx));
+    if(name->get_token() != token_t::TOK_QUOTED)
+    {
+        return false;
+    }
+
+    std::string function;
+    std::size_t slot(0);
+    auto const local_slot(f_local_slots.find(name->get_word()));
+    if(local_slot != f_local_slots.end())
+    {
+        function = local ? "declare_local" : "set_local_value";
+        slot = local_slot->second;
+    }
+    else if(!local)
+    {
+        auto const argument_slot(f_argument_slots.find(name->get_word()));
+        if(argument_slot == f_argument_slots.end())
+        {
+            return false;
+        }
+        function = "set_slot_value";
+        slot = argument_slot->second;
+    }
+    else
+    {
+        return false;
+    }
+
+    std::string const value_name(get_unique_name());
+    f_out << "{\n";
+    output_argument(control_info.f_function_call->get_list_item(1 - name_idx), value_name);
+    f_out << "context->"
+          << function
+          << "("
+          << slot
+          << ","
+          << value_name
+          << ");\n"
+             "}\n";
+
+    return true;
+}
 
 
 void Parser::primitive_thing(control_t & control_info)
@@ -117,9 +1092,9 @@ void Parser::primitive_thing(control_t & control_info)
         value_name = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -133,9 +1108,9 @@ void Parser::primitive_thing(control_t & control_info)
     if(direct_value)
     {
         f_out << control_info.f_result_var
-              << "=context->get_thing("
-              << word_to_cpp_string_literal(thing_name)
-              << ")->get_value();\n";
+              << "="
+              << get_thing_value(thing_name)
+              << ";\n";
     }
     else
     {
@@ -196,9 +1171,9 @@ void Parser::primitive_wait(control_t & control_info)
         value_name = get_unique_name();
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     default:
@@ -20,59 +20,119 @@
 
 #include "exception.hpp"
 
-#include <fstream>
 #include <iostream>
 #include <limits>
-#include <sstream>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace lpp
 {
 
 
 
+/** \brief Read a Logo source file.
+ *
+ * The whole file is made available in memory before lexing starts:
+ * regular files are mapped and anything else (stdin, pipes) is read
+ * in one go. The lexer then scans the buffer with a pointer.
+ *
+ * \param[in] filename  The name of the file or "-" for stdin.
+ */
 Lexer::Lexer(std::string const & filename)
     : f_filename(filename)
 {
     if(filename == "-")
     {
-        f_in = &std::cin;
+        read_all(0);
+        return;
     }
-    else
+
+    int const fd(open(filename.c_str(), O_RDONLY | O_CLOEXEC));
+    if(fd < 0)
+    {
+        throw lpp_error("could not open file \""
+                      + filename
+                      + "\".");
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) == 0
+    && S_ISREG(st.st_mode)
+    && st.st_size > 0)
     {
-        std::ifstream * file(new std::ifstream);
-        file->open(filename);
-        if(!file->is_open())
+        void * map(mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+        if(map != MAP_FAILED)
         {
-            delete file;
-            throw lpp_error("could not open file \""
-                          + filename
-                          + "\".");
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            f_map = map;
+            f_map_size = st.st_size;
+            f_pos = static_cast<char const *>(map);
+            f_end = f_pos + f_map_size;
+            close(fd);
+            return;
         }
-        f_file = file;
-        f_in = file;
     }
+
+    try
+    {
+        read_all(fd);
+    }
+    catch(...)
+    {
+        close(fd);
+        throw;
+    }
+    close(fd);
 }
 
 
 Lexer::Lexer(std::string const & filename, std::string const & primitive)
     : f_filename(filename)
+    , f_data(primitive)
+    , f_pos(f_data.data())
+    , f_end(f_data.data() + f_data.length())
+    , f_line(1)
 {
-    std::stringstream * file = new std::stringstream;
-    *file << primitive;
-    file->seekg(0);
-
-    f_file = file;
-    f_in = file;
-    f_line = 1;
 }
 
 
 Lexer::~Lexer()
 {
-    if(f_file != nullptr)
+    if(f_map != nullptr)
+    {
+        munmap(f_map, f_map_size);
+    }
+}
+
+
+void Lexer::read_all(int fd)
+{
+    char buf[64 * 1024];
+    for(;;)
     {
-        delete f_file;
+        ssize_t const r(read(fd, buf, sizeof(buf)));
+        if(r == 0)
+        {
+            break;
+        }
+        if(r < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            throw lpp_error("could not read file \""
+                          + f_filename
+                          + "\".");
+        }
+        f_data.append(buf, r);
     }
+    f_pos = f_data.data();
+    f_end = f_pos + f_data.length();
 }
 
 
@@ -98,31 +158,88 @@ Lexer::char_type Lexer::getc()
             return f_unget_chars[f_unget_pos];
         }
 
-        auto result(f_in->get());
-        if(result == '\r')
+        if(f_pos >= f_end)
         {
-            result = f_in->get();
-            if(result != '\n')
-            {
-                ungetc(result);
-                result = '\n';
-            }
+            return std::istream::traits_type::eof();
         }
-        if(result == '\n')
+
+        char_type const result(static_cast<unsigned char>(*f_pos));
+        ++f_pos;
+        if(result != '\n'
+        && result != '\r')
         {
-            ++f_line;
-            auto const line_continuation(f_in->get());
-            if(line_continuation != '~')
-            {
-                ungetc(line_continuation);
-                return static_cast<char_type>(result);
-            }
+            return result;
+        }
+
+        // "\r\n" and "\r" are both new lines
+        //
+        if(result == '\r'
+        && f_pos < f_end
+        && *f_pos == '\n')
+        {
+            ++f_pos;
         }
-        else
+
+        ++f_line;
+        if(f_pos >= f_end
+        || *f_pos != '~')
         {
-            return static_cast<char_type>(result);
+            return '\n';
+        }
+
+        // skip the "~" of the line continuation
+        //
+        ++f_pos;
+    }
+}
+
+
+/** \brief Find the end of the plain characters of a word.
+ *
+ * The characters which end a word or need special handling (bars,
+ * backslashes, new lines, ...) are left to getc() and get_word().
+ * All the others can be copied from the buffer as is.
+ *
+ * \param[in] quoted  Whether the word is quoted (operators are then
+ * part of the word).
+ *
+ * \return A pointer to the first character which is not plain.
+ */
+char const * Lexer::plain_word_end(bool quoted) const
+{
+    char const * p(f_pos);
+    for(; p < f_end; ++p)
+    {
+        switch(*p)
+        {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '|':
+        case '\\':
+        case '(':
+        case ')':
+        case '[':
+        case ']':
+            return p;
+
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '<':
+        case '>':
+        case '=':
+            if(!quoted)
+            {
+                return p;
+            }
+            break;
+
         }
     }
+    return p;
 }
 
 
@@ -203,13 +320,22 @@ Token::pointer_t Lexer::next_token()
                         }
                     }
                     word += c;
+
+                    // copy the plain characters that follow in one go
+                    //
+                    if(f_unget_pos == 0)
+                    {
+                        char const * end(plain_word_end(quoted));
+                        word.append(f_pos, end);
+                        f_pos = end;
+                    }
                 }
 
                 c = getc();
             }
         };
 
-    Token::pointer_t result(std::make_shared<Token>(token_t::TOK_EOF, f_filename, f_line));
+    Token::pointer_t result(make_token(token_t::TOK_EOF, f_filename, f_line));
     for(;;)
     {
         char_type c(getc());
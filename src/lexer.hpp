@@ -40,13 +40,18 @@ public:
     Token::pointer_t    next_token();
 
 private:
+    void                read_all(int fd);
     void                ungetc(char_type c);
     char_type           getc();
+    char const *        plain_word_end(bool quoted) const;
     bool                isspace(char_type c) const;
 
     std::string         f_filename = std::string();
-    std::istream *      f_file = nullptr;
-    std::istream *      f_in = nullptr;
+    std::string         f_data = std::string();         // stdin or a file which cannot be mapped
+    void *              f_map = nullptr;
+    std::size_t         f_map_size = 0;
+    char const *        f_pos = nullptr;
+    char const *        f_end = nullptr;
     line_t              f_line = 0;
     std::uint_fast8_t   f_unget_pos = 0;
     char_type           f_unget_chars[2];
@@ -35,12 +35,32 @@ void usage()
     std::cout << "Usage: lpp <-opts> <file>.logo ...\n\n"
 
 "Where -opts is one or more of:\n"
+"  --cache | --no-cache     reuse the objects compiled earlier (default) or\n"
+"                           compile all of them in a temporary directory;\n"
+"                           to clear the cache, remove the cache directory\n"
+"  --cache-dir <path>       directory where the compiled objects are cached\n"
+"                           (default $XDG_CACHE_HOME/lpp or ~/.cache/lpp)\n"
+"  --cache-max-age <days>   remove the cached objects not used for that many\n"
+"                           days (default 30, 0 keeps them forever)\n"
 "  --copyright              print out this program copyright notice\n"
 "  --enable-trace           instruments the code so tracing works (for debug)\n"
 "  --disable-trace          do not instruments the code for tracing (will be faster)\n"
 "  --help | -h              print out this help screen\n"
+"  --jobs=N | -j<N>         number of g++ processes to run in parallel\n"
+"                           (default: number of processors)\n"
 "  --license                print out this program full license\n"
+"  --lto | --no-lto         turn link time optimization on or off\n"
+"  --march-native           optimize for the processor running the compiler\n"
+"  --optimize=N | -O<N>     optimization level: 0, 1, 2, 3, or s (default 0);\n"
+"                           any level but 0 also folds constants and removes\n"
+"                           dead code in the Logo program\n"
 "  --output-object          generate a .o as the output\n"
+"  --release                release profile: -O2 and no trace unless\n"
+"                           specified otherwise on the command line\n"
+"  --static                 link a static executable; with --lto the runtime\n"
+"                           gets optimized along with the Logo program\n"
+"                           (the glibc warnings about getpwuid() and\n"
+"                           getgrgid() needing shared libraries are hidden)\n"
 "  --version                print out the compiler version\n"
 
 ;
@@ -54,6 +74,9 @@ int main(int argc, char * argv[])
         lpp::Parser::pointer_t parser(std::make_shared<lpp::Parser>());
         lpp::Compiler::pointer_t compiler(std::make_shared<lpp::Compiler>());
         bool do_compile(true);
+        bool release(false);
+        bool explicit_trace(false);
+        bool explicit_optimization(false);
 
         bool stdin_used_up(false);
         for(int i(1); i < argc; ++i)
@@ -131,10 +154,12 @@ int main(int argc, char * argv[])
                         else if(arg == "enable-trace")
                         {
                             parser->set_trace(true);
+                            explicit_trace = true;
                         }
                         else if(arg == "disable-trace")
                         {
                             parser->set_trace(false);
+                            explicit_trace = true;
                         }
                         else if(arg == "do-compile")
                         {
@@ -156,6 +181,38 @@ int main(int argc, char * argv[])
                         {
                             compiler->set_include_debug(false);
                         }
+                        else if(arg == "optimize")
+                        {
+                            if(equal != std::string::npos)
+                            {
+                                compiler->set_optimization_level(value);
+                            }
+                            else
+                            {
+                                compiler->set_optimization_level(get_next_param());
+                            }
+                            explicit_optimization = true;
+                        }
+                        else if(arg == "march-native")
+                        {
+                            compiler->set_march_native(true);
+                        }
+                        else if(arg == "lto")
+                        {
+                            compiler->set_lto(true);
+                        }
+                        else if(arg == "no-lto")
+                        {
+                            compiler->set_lto(false);
+                        }
+                        else if(arg == "static")
+                        {
+                            compiler->set_static(true);
+                        }
+                        else if(arg == "release")
+                        {
+                            release = true;
+                        }
                         else if(arg == "main-cpp")
                         {
                             if(equal != std::string::npos)
@@ -178,6 +235,47 @@ int main(int argc, char * argv[])
                                 compiler->set_output(get_next_param());
                             }
                         }
+                        else if(arg == "cache-dir")
+                        {
+                            if(equal != std::string::npos)
+                            {
+                                compiler->set_cache_dir(value);
+                            }
+                            else
+                            {
+                                compiler->set_cache_dir(get_next_param());
+                            }
+                        }
+                        else if(arg == "cache-max-age")
+                        {
+                            if(equal != std::string::npos)
+                            {
+                                compiler->set_cache_max_age(value);
+                            }
+                            else
+                            {
+                                compiler->set_cache_max_age(get_next_param());
+                            }
+                        }
+                        else if(arg == "cache")
+                        {
+                            compiler->set_cache(true);
+                        }
+                        else if(arg == "no-cache")
+                        {
+                            compiler->set_cache(false);
+                        }
+                        else if(arg == "jobs")
+                        {
+                            if(equal != std::string::npos)
+                            {
+                                compiler->set_jobs(value);
+                            }
+                            else
+                            {
+                                compiler->set_jobs(get_next_param());
+                            }
+                        }
                         else if(arg == "include-path")
                         {
                             if(equal != std::string::npos)
@@ -302,6 +400,31 @@ int main(int argc, char * argv[])
                         }
                         break;
 
+                    case 'j':
+                        if(argv[i][2] == '\0')
+                        {
+                            compiler->set_jobs(get_next_param());
+                        }
+                        else
+                        {
+                            compiler->set_jobs(argv[i] + 2);
+                        }
+                        break;
+
+                    case 'O':
+                        // like g++, a plain -O means -O1
+                        //
+                        if(argv[i][2] == '\0')
+                        {
+                            compiler->set_optimization_level("1");
+                        }
+                        else
+                        {
+                            compiler->set_optimization_level(argv[i] + 2);
+                        }
+                        explicit_optimization = true;
+                        break;
+
                     default:
                         {
                             int const len(std::strlen(argv[i]));
@@ -321,10 +444,12 @@ int main(int argc, char * argv[])
 
                                 case 't':
                                     parser->set_trace(true);
+                                    explicit_trace = true;
                                     break;
 
                                 case 'g':
                                     parser->set_trace(true);
+                                    explicit_trace = true;
                                     compiler->set_include_debug(true);
                                     break;
 
@@ -361,7 +486,26 @@ int main(int argc, char * argv[])
             }
         }
 
+        if(release)
+        {
+            // the release profile only changes what was not explicitly
+            // specified on the command line
+            //
+            if(!explicit_optimization)
+            {
+                compiler->set_optimization_level("2");
+            }
+            if(!explicit_trace)
+            {
+                parser->set_trace(false);
+            }
+        }
+
         parser->parse();
+        if(compiler->get_optimization_level() != "0")
+        {
+            parser->optimize();
+        }
         parser->generate();
 
         if(!do_compile)
@@ -370,6 +514,10 @@ int main(int argc, char * argv[])
         }
 
         compiler->set_has_program(parser->has_program());
+        for(auto const & source : parser->get_sources())
+        {
+            compiler->add_source(source);
+        }
         return compiler->compile();
     }
     catch(std::logic_error const & e)
@@ -0,0 +1,782 @@
+// lpp -- Logo to binary compiler
+// Copyright (C) 2019  Made to Order Software Corporation
+// https://www.m2osw.com/lpp
+// contact@m2osw.com
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// self
+//
+#include "parser.hpp"
+
+// lpp compiler
+//
+#include "utf8_iterator.hpp"
+
+// C++ lib
+//
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+
+
+namespace lpp
+{
+
+
+namespace
+{
+
+
+
+/** \brief A number as handled by lpp__number at run time.
+ *
+ * The folding of arithmetic has to give the exact same results as the
+ * run time, so numbers are kept as integers until a float is involved.
+ */
+struct number_t
+{
+    bool            f_is_integer = true;
+    integer_t       f_integer = 0;
+    float_t         f_float = 0.0;
+};
+
+
+bool get_number(Token::pointer_t token, number_t & number)
+{
+    switch(token->get_token())
+    {
+    case token_t::TOK_INTEGER:
+        number.f_is_integer = true;
+        number.f_integer = token->get_integer();
+        return true;
+
+    case token_t::TOK_FLOAT:
+        number.f_is_integer = false;
+        number.f_float = token->get_float();
+        return true;
+
+    default:
+        return false;
+
+    }
+}
+
+
+float_t to_float(number_t const & number)
+{
+    return number.f_is_integer
+                ? static_cast<float_t>(number.f_integer)
+                : number.f_float;
+}
+
+
+/** \brief Get the word a literal represents.
+ *
+ * Only quoted words and integers are converted, the conversion of the
+ * other literals is not guaranteed to match the run time.
+ */
+bool get_word(Token::pointer_t token, std::string & word)
+{
+    switch(token->get_token())
+    {
+    case token_t::TOK_QUOTED:
+        word = token->get_word();
+        return true;
+
+    case token_t::TOK_INTEGER:
+        word = std::to_string(token->get_integer());
+        return true;
+
+    default:
+        return false;
+
+    }
+}
+
+
+/** \brief Check whether a list only includes literals.
+ *
+ * Lists may include function calls and things which do not represent
+ * what they look like; those lists are not folded.
+ */
+bool is_literal_list(Token::pointer_t list)
+{
+    if(list->get_token() != token_t::TOK_LIST)
+    {
+        return false;
+    }
+
+    auto const max(list->get_list_size());
+    for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+    {
+        Token::pointer_t item(list->get_list_item(idx));
+        switch(item->get_token())
+        {
+        case token_t::TOK_WORD:
+        case token_t::TOK_QUOTED:
+        case token_t::TOK_INTEGER:
+        case token_t::TOK_FLOAT:
+        case token_t::TOK_BOOLEAN:
+            break;
+
+        case token_t::TOK_LIST:
+            if(!is_literal_list(item))
+            {
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+
+        }
+    }
+
+    return true;
+}
+
+
+Token::pointer_t make_word(Token::pointer_t location, std::string const & word)
+{
+    Token::pointer_t result(make_token(token_t::TOK_EOF, location));
+    result->set_word(token_t::TOK_QUOTED, word);
+    return result;
+}
+
+
+Token::pointer_t make_boolean(Token::pointer_t location, bool value)
+{
+    Token::pointer_t result(make_token(token_t::TOK_BOOLEAN, location));
+    result->set_boolean(value);
+    return result;
+}
+
+
+/** \brief Transform a list item in a value.
+ *
+ * In a list, a word is a TOK_WORD; once extracted from the list it has
+ * to be a TOK_QUOTED or it would be viewed as a procedure call.
+ */
+Token::pointer_t list_item_value(Token::pointer_t item)
+{
+    if(item->get_token() == token_t::TOK_WORD)
+    {
+        return make_word(item, item->get_word());
+    }
+    return item;
+}
+
+
+Token::pointer_t make_number(Token::pointer_t location, number_t const & number)
+{
+    Token::pointer_t result(make_token(token_t::TOK_EOF, location));
+    if(number.f_is_integer)
+    {
+        result->set_token(token_t::TOK_INTEGER);
+        result->set_integer(number.f_integer);
+    }
+    else
+    {
+        // like lpp__number::to_value(), a float without a fraction
+        // becomes an integer
+        //
+        float_t integral_part(0.0);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+        if(std::modf(number.f_float, &integral_part) == 0.0)
+#pragma GCC diagnostic pop
+        {
+            result->set_token(token_t::TOK_INTEGER);
+            result->set_integer(static_cast<integer_t>(number.f_float));
+        }
+        else
+        {
+            result->set_token(token_t::TOK_FLOAT);
+            result->set_float(number.f_float);
+        }
+    }
+    return result;
+}
+
+
+
+} // no name namespace
+
+
+
+
+/** \brief Optimize the procedures and the program.
+ *
+ * This pass goes through the bodies once they are parsed and:
+ *
+ * \li folds calls to pure primitives which only receive literals
+ * (i.e. `SUM 3 7` becomes `10` and `item 3 [a b c d e f]` becomes `"c`);
+ * \li replaces IF and IFELSE with a constant condition by the
+ * instructions of the branch which gets executed;
+ * \li removes the instructions following an OUTPUT, STOP or THROW
+ * up to the next TAG.
+ *
+ * Note that at first this may not look useful for basic arithmetics
+ * since the C++ compiler will take care of such optimizations, but the
+ * generated code boxes all the values so the C++ compiler does not see
+ * through them.
+ */
+void Parser::optimize()
+{
+    f_folded = 0;
+
+    auto const & procedures(f_procedures->get_map());
+    for(auto p : procedures)
+    {
+        auto const max(p.second->get_list_size());
+        p.second->set_list_item(max - 1, optimize_body(p.second->get_list_item(max - 1)));
+    }
+
+    f_program = optimize_body(f_program);
+
+    if(f_verbose)
+    {
+        std::cerr << "info: the optimizer folded "
+                  << f_folded
+                  << " node"
+                  << (f_folded == 1 ? "" : "s")
+                  << ".\n";
+    }
+}
+
+
+/** \brief Optimize a list of instructions.
+ *
+ * The function returns a new list since instructions may be added
+ * (the branch of a constant IF) or removed (unreachable code).
+ *
+ * \param[in] body  The list of instructions to optimize.
+ *
+ * \return The optimized list of instructions.
+ */
+Token::pointer_t Parser::optimize_body(Token::pointer_t body)
+{
+    Token::pointer_t new_body(make_token(token_t::TOK_LIST, body));
+
+    bool unreachable(false);
+    auto const max(body->get_list_size());
+    for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+    {
+        Token::pointer_t item(body->get_list_item(idx));
+        if(item->get_token() != token_t::TOK_FUNCTION_CALL
+        || item->get_declaration() == nullptr)
+        {
+            if(!unreachable)
+            {
+                new_body->add_list_item(item);
+            }
+            continue;
+        }
+
+        std::string const & name(item->get_declaration()->get_word());
+        if(unreachable)
+        {
+            // a GOTO can jump to a TAG so the code that follows is alive
+            //
+            if(name != "tag")
+            {
+                ++f_folded;
+                continue;
+            }
+            unreachable = false;
+        }
+
+        optimize_call(item);
+
+        // a list (the condition of a WHILE, for example) may include
+        // an expression by itself
+        //
+        if((item->get_declaration()->get_procedure_flags() & PROCEDURE_FLAG_FUNCTION) != 0)
+        {
+            Token::pointer_t folded(fold_call(item));
+            if(folded != nullptr)
+            {
+                ++f_folded;
+                new_body->add_list_item(folded);
+                continue;
+            }
+        }
+
+        if((name == "if" || name == "ifelse")
+        && (item->get_list_size() == 2 || item->get_list_size() == 3)
+        && item->get_list_item(0)->get_token() == token_t::TOK_BOOLEAN)
+        {
+            ++f_folded;
+
+            std::size_t const branch(item->get_list_item(0)->get_boolean() ? 1 : 2);
+            if(branch < item->get_list_size())
+            {
+                Token::pointer_t instruction_list(item->get_list_item(branch));
+                if(instruction_list->get_token() == token_t::TOK_LIST)
+                {
+                    Token::pointer_t instructions(optimize_body(parse_body(instruction_list)));
+                    auto const count(instructions->get_list_size());
+                    for(std::remove_const<decltype(count)>::type i(0); i < count; ++i)
+                    {
+                        new_body->add_list_item(instructions->get_list_item(i));
+                    }
+                    if(count > 0
+                    && is_terminator(instructions->get_list_item(count - 1)))
+                    {
+                        unreachable = true;
+                    }
+                }
+                else
+                {
+                    // let the code generator report the error
+                    //
+                    --f_folded;
+                    new_body->add_list_item(item);
+                }
+            }
+            continue;
+        }
+
+        new_body->add_list_item(item);
+
+        if(is_terminator(item))
+        {
+            unreachable = true;
+        }
+    }
+
+    return new_body;
+}
+
+
+/** \brief Optimize the arguments of a function call.
+ *
+ * The arguments which are function calls get folded when possible.
+ * The lists passed to control primitives are instructions (IF, REPEAT,
+ * WHILE...) so they get optimized as bodies. The other lists are data
+ * and are left alone.
+ *
+ * \param[in,out] call  The function call to optimize.
+ */
+void Parser::optimize_call(Token::pointer_t call)
+{
+    Token::pointer_t declaration(call->get_declaration());
+    if(declaration == nullptr)
+    {
+        return;
+    }
+    bool const control((declaration->get_procedure_flags() & PROCEDURE_FLAG_CONTROL) != 0);
+
+    auto const max(call->get_list_size());
+    for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+    {
+        Token::pointer_t arg(call->get_list_item(idx));
+        switch(arg->get_token())
+        {
+        case token_t::TOK_FUNCTION_CALL:
+            {
+                optimize_call(arg);
+                Token::pointer_t folded(fold_call(arg));
+                if(folded != nullptr)
+                {
+                    ++f_folded;
+                    call->set_list_item(idx, folded);
+                }
+            }
+            break;
+
+        case token_t::TOK_LIST:
+            if(control)
+            {
+                call->set_list_item(idx, optimize_body(arg));
+            }
+            break;
+
+        default:
+            break;
+
+        }
+    }
+}
+
+
+/** \brief Check whether a call ends the current list of instructions.
+ *
+ * \param[in] item  The instruction to check.
+ *
+ * \return true if the instructions following \p item are not reachable.
+ */
+bool Parser::is_terminator(Token::pointer_t item)
+{
+    if(item->get_token() != token_t::TOK_FUNCTION_CALL
+    || item->get_declaration() == nullptr)
+    {
+        return false;
+    }
+
+    std::string const & name(item->get_declaration()->get_word());
+    return name == "output"
+        || name == "stop"
+        || name == "throw";
+}
+
+
+/** \brief Compute the result of a function call at compile time.
+ *
+ * Only primitives without side effects and only receiving literals
+ * get folded. Anything which would generate an error at run time
+ * (a division by zero, an empty list...) is not folded so the error
+ * still happens at run time.
+ *
+ * \param[in] call  The function call to fold.
+ *
+ * \return The literal replacing the call or nullptr.
+ */
+Token::pointer_t Parser::fold_call(Token::pointer_t call)
+{
+    Token::pointer_t declaration(call->get_declaration());
+    if(declaration == nullptr
+    || (declaration->get_procedure_flags() & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PRIMITIVE)
+    {
+        return Token::pointer_t();
+    }
+
+    std::string const & name(declaration->get_word());
+    auto const max(call->get_list_size());
+
+    if(name == "sum"
+    || name == "difference"
+    || name == "product"
+    || name == "quotient"
+    || name == "minus"
+    || name == "plus")
+    {
+        bool const unary(name == "minus" || name == "plus");
+        if(unary ? max != 1 : max < 2)
+        {
+            return Token::pointer_t();
+        }
+
+        number_t result;
+        if(!get_number(call->get_list_item(0), result))
+        {
+            return Token::pointer_t();
+        }
+
+        if(unary)
+        {
+            if(name == "minus")
+            {
+                if(result.f_is_integer)
+                {
+                    if(result.f_integer == std::numeric_limits<integer_t>::min())
+                    {
+                        return Token::pointer_t();
+                    }
+                    result.f_integer = -result.f_integer;
+                }
+                else
+                {
+                    result.f_float = -result.f_float;
+                }
+            }
+        }
+        else
+        {
+            for(std::remove_const<decltype(max)>::type idx(1); idx < max; ++idx)
+            {
+                number_t rhs;
+                if(!get_number(call->get_list_item(idx), rhs))
+                {
+                    return Token::pointer_t();
+                }
+
+                if(name == "quotient")
+                {
+                    // QUOTIENT always divides floats
+                    //
+                    float_t const divisor(to_float(rhs));
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+                    if(divisor == 0.0)
+#pragma GCC diagnostic pop
+                    {
+                        return Token::pointer_t();
+                    }
+                    result.f_float = to_float(result) / divisor;
+                    result.f_is_integer = false;
+                }
+                else if(result.f_is_integer && rhs.f_is_integer)
+                {
+                    bool overflow(false);
+                    if(name == "sum")
+                    {
+                        overflow = __builtin_add_overflow(result.f_integer, rhs.f_integer, &result.f_integer);
+                    }
+                    else if(name == "difference")
+                    {
+                        overflow = __builtin_sub_overflow(result.f_integer, rhs.f_integer, &result.f_integer);
+                    }
+                    else
+                    {
+                        overflow = __builtin_mul_overflow(result.f_integer, rhs.f_integer, &result.f_integer);
+                    }
+                    if(overflow)
+                    {
+                        return Token::pointer_t();
+                    }
+                }
+                else
+                {
+                    float_t const l(to_float(result));
+                    float_t const r(to_float(rhs));
+                    if(name == "sum")
+                    {
+                        result.f_float = l + r;
+                    }
+                    else if(name == "difference")
+                    {
+                        result.f_float = l - r;
+                    }
+                    else
+                    {
+                        result.f_float = l * r;
+                    }
+                    result.f_is_integer = false;
+                }
+            }
+        }
+
+        // the run time would convert an infinity or a huge float to
+        // an integer with an undefined result
+        //
+        if(!result.f_is_integer
+        && (!std::isfinite(result.f_float)
+            || std::fabs(result.f_float) >= 9.2e18))
+        {
+            return Token::pointer_t();
+        }
+
+        return make_number(call, result);
+    }
+
+    if(name == "lessp"
+    || name == "lessequalp"
+    || name == "greaterp"
+    || name == "greaterequalp"
+    || name == "equalp"
+    || name == "notequalp")
+    {
+        number_t lhs;
+        number_t rhs;
+        if(max != 2
+        || !get_number(call->get_list_item(0), lhs)
+        || !get_number(call->get_list_item(1), rhs))
+        {
+            return Token::pointer_t();
+        }
+
+        int c(0);
+        if(lhs.f_is_integer && rhs.f_is_integer)
+        {
+            c = lhs.f_integer < rhs.f_integer ? -1 : (lhs.f_integer > rhs.f_integer ? 1 : 0);
+        }
+        else
+        {
+            float_t const l(to_float(lhs));
+            float_t const r(to_float(rhs));
+            if(std::isunordered(l, r))
+            {
+                return Token::pointer_t();
+            }
+            c = l < r ? -1 : (l > r ? 1 : 0);
+        }
+
+        bool result(false);
+        if(name == "lessp")
+        {
+            result = c < 0;
+        }
+        else if(name == "lessequalp")
+        {
+            result = c <= 0;
+        }
+        else if(name == "greaterp")
+        {
+            result = c > 0;
+        }
+        else if(name == "greaterequalp")
+        {
+            result = c >= 0;
+        }
+        else if(name == "equalp")
+        {
+            result = c == 0;
+        }
+        else
+        {
+            result = c != 0;
+        }
+        return make_boolean(call, result);
+    }
+
+    if(name == "count")
+    {
+        if(max != 1)
+        {
+            return Token::pointer_t();
+        }
+        Token::pointer_t thing(call->get_list_item(0));
+        number_t count;
+        std::string word;
+        if(is_literal_list(thing))
+        {
+            count.f_integer = thing->get_list_size();
+        }
+        else if(get_word(thing, word))
+        {
+            count.f_integer = word.length();
+        }
+        else
+        {
+            return Token::pointer_t();
+        }
+        return make_number(call, count);
+    }
+
+    if(name == "first"
+    || name == "last")
+    {
+        if(max != 1)
+        {
+            return Token::pointer_t();
+        }
+        Token::pointer_t thing(call->get_list_item(0));
+        std::string word;
+        if(is_literal_list(thing))
+        {
+            auto const size(thing->get_list_size());
+            if(size == 0)
+            {
+                return Token::pointer_t();
+            }
+            return list_item_value(thing->get_list_item(name == "first" ? 0 : size - 1));
+        }
+        if(get_word(thing, word))
+        {
+            if(word.empty())
+            {
+                return Token::pointer_t();
+            }
+            if(name == "first")
+            {
+                utf8_iterator const it(word);
+                return make_word(call, wctombs(*it));
+            }
+            utf8_iterator it(word, true);
+            return make_word(call, wctombs(*--it));
+        }
+        return Token::pointer_t();
+    }
+
+    if(name == "item")
+    {
+        number_t position;
+        if(max != 2
+        || !get_number(call->get_list_item(0), position))
+        {
+            return Token::pointer_t();
+        }
+        integer_t const idx(position.f_is_integer
+                                ? position.f_integer
+                                : static_cast<integer_t>(position.f_float));
+        if(idx <= 0)
+        {
+            return Token::pointer_t();
+        }
+        Token::pointer_t thing(call->get_list_item(1));
+        std::string word;
+        if(is_literal_list(thing))
+        {
+            if(static_cast<std::size_t>(idx) > thing->get_list_size())
+            {
+                return Token::pointer_t();
+            }
+            return list_item_value(thing->get_list_item(idx - 1));
+        }
+        if(get_word(thing, word))
+        {
+            if(static_cast<std::size_t>(idx) > word.length())
+            {
+                return Token::pointer_t();
+            }
+            return make_word(call, word.substr(idx - 1, 1));
+        }
+        return Token::pointer_t();
+    }
+
+    if(name == "word")
+    {
+        std::string result;
+        for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+        {
+            std::string word;
+            if(!get_word(call->get_list_item(idx), word))
+            {
+                return Token::pointer_t();
+            }
+            result += word;
+        }
+        return make_word(call, result);
+    }
+
+    if(name == "sentence")
+    {
+        Token::pointer_t result(make_token(token_t::TOK_LIST, call));
+        for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+        {
+            Token::pointer_t thing(call->get_list_item(idx));
+            if(is_literal_list(thing))
+            {
+                auto const size(thing->get_list_size());
+                for(std::remove_const<decltype(size)>::type i(0); i < size; ++i)
+                {
+                    result->add_list_item(thing->get_list_item(i));
+                }
+            }
+            else if(thing->get_token() == token_t::TOK_QUOTED
+                 || thing->get_token() == token_t::TOK_INTEGER
+                 || thing->get_token() == token_t::TOK_FLOAT
+                 || thing->get_token() == token_t::TOK_BOOLEAN)
+            {
+                result->add_list_item(thing);
+            }
+            else
+            {
+                return Token::pointer_t();
+            }
+        }
+        return result;
+    }
+
+    return Token::pointer_t();
+}
+
+
+
+} // lpp namespace
+
+// vim: ts=4 sw=4 et nocindent
@@ -26,6 +26,8 @@
 
 // common files
 //
+#include "perfect_hash.hpp"
+#include "primitives.hpp"
 #include "utf8_iterator.hpp"
 
 // boost lib
@@ -34,9 +36,19 @@
 
 // C++ lib
 //
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <thread>
+
+// C lib
+//
+#include <stdlib.h>
+#include <unistd.h>
 
 
 
@@ -46,225 +58,29 @@ namespace lpp
 
 
 Parser::Parser()
-    : f_program(std::make_shared<Token>(token_t::TOK_LIST))
-    , f_declarations(std::make_shared<Token>(token_t::TOK_MAP))
-    , f_procedures(std::make_shared<Token>(token_t::TOK_MAP))
+    : f_program(make_token(token_t::TOK_LIST))
+    , f_declarations(make_token(token_t::TOK_MAP))
+    , f_procedures(make_token(token_t::TOK_MAP))
+{
+    declare_primitives();
+}
+
+
+/** \brief Create a reader for one input file.
+ *
+ * read_inputs() creates one such parser per file. It only runs
+ * input_lines() so it does not need the primitives.
+ *
+ * \param[in] lexer  The lexer of the file to read.
+ * \param[in] output_object  Whether the --output-object option is used.
+ */
+Parser::Parser(Lexer::pointer_t lexer, bool output_object)
+    : f_output_object(output_object)
+    , f_lexer{lexer}
+    , f_program(make_token(token_t::TOK_LIST))
+    , f_declarations(make_token(token_t::TOK_MAP))
+    , f_procedures(make_token(token_t::TOK_MAP))
 {
-    add_lexer(std::make_shared<Lexer>("primitives.logo",                                    // Current status
-            // A
-            "primitive [function] allopen end allopen\n"                                    // external
-            "primitive [function logic] and :boolean1 :boolean2 [:rest] end\n"              // external
-            "primitive [function arithmetic] arccos :number1 end\n"                         // external
-            "primitive [function arithmetic] arcsin :number1 end\n"                         // external
-            "primitive [function arithmetic] arctan :number1 [:number2] end\n"              // external
-            "primitive [function] arity :name end arity\n"                                  // external
-            "primitive [function arithmetic] ashift :number :shift end\n"                   // external
-            // B
-            "primitive [function] backslashedp&backslashed? :char end\n"                    // external
-            "primitive [function] beforep&before? :word1 :word2 end\n"                      // external
-            "primitive [function arithmetic] bitand :number1 :number2 [:rest] end\n"        // external
-            "primitive [function arithmetic] bitnot :number end\n"                          // external
-            "primitive [function arithmetic] bitor :number1 :number2 [:rest] end\n"         // external
-            "primitive [function arithmetic] bitxor :number1 :number2 [:rest] end\n"        // external
-            "primitive [function] butfirst&bf :thing end\n"                                 // external
-            "primitive [function] butlast&bl :thing end\n"                                  // external
-            "primitive [procedure] bye [:code 0] end\n"                                     // external
-            "primitive [function] byte :word end byte\n"                                    // external
-            // C
-            "primitive [procedure control inline] call :name :arguments end call\n"         // inline
-            "primitive [function control inline] callfunction :name :arguments end callfunction\n"
-                                                                                            // inline
-            "primitive [procedure control inline] case :value :clauses end case\n"          // MISSING
-            "primitive [procedure control inline] catch :tag :instructions end catch\n"     // inline
-            "primitive [function] char :number end char\n"                                  // external
-            "primitive [procedure] cleartext&ct end cleartext\n"                            // external
-            "primitive [procedure] close :filename [:force true] end close\n"               // external
-            "primitive [procedure] closeall end closeall\n"                                 // external
-            "primitive [function] combine :thing1 :thing2 end\n"                            // external
-            "primitive [function arithmetic] comparablep&comparable? :thing1 :thing2 end\n" // external
-            "primitive [procedure control inline] cond :clauses end cond\n"                 // MISSING
-            "primitive [function arithmetic] cos :number1 end\n"                            // external
-            "primitive [function] count :thing end\n"                                       // external
-            "primitive [function] cursor end\n"                                             // external
-            // D
-            "primitive [function] definedp&defined? :name end\n"                            // external
-            "primitive [function arithmetic] difference :number1 :number2 [:rest] end\n"    // external
-            "primitive [function] dequeue :queue end\n"                                     // external
-            "primitive [procedure control inline] do.until :boolean :once_and_if_false end\n"   // inline
-            "primitive [procedure control inline] do.while :boolean :once_and_if_true end\n"    // inline
-            // E
-            "primitive [function] emptyp&empty? :thing end\n"                               // external
-            "primitive [function] equalp&equal? :thing1 :thing2 [:rest] end\n"              // external
-            "primitive [function] eofp&eof? :filename end eofp\n"                           // external
-            "primitive [procedure] erase&er :names end erase\n"                             // external
-            "primitive [procedure] erasefile&erf :filename end erasefile\n"                 // external
-            "primitive [function] error end\n"                                              // external
-            "primitive [function] errorp&error? end\n"                                      // external
-            // F
-            "primitive [function] fileinfo :filename end\n"                                 // external
-            "primitive [function] filep&file? :filename end\n"                              // external
-            "primitive [function] first :thing end\n"                                       // external
-            "primitive [function] firstbyte :word end firstbyte\n"                          // external
-            "primitive [function] floatp&float? :thing end\n"                               // external
-            "primitive [procedure control inline] for :control :instructions end\n"         // inline
-            "primitive [procedure control inline] forever :instructions end\n"              // inline
-            "primitive [function] fput :item :thing end\n"                                  // external
-            // G
-            "primitive [function] gensym end\n"                                             // external
-            "primitive [procedure control inline] goto :tag end\n"                          // inline
-            "primitive [function] gprop :plistname :propname end gprop\n"                   // external
-            "primitive [function] greaterequalp&greaterequal? :thing1 :thing2 [:rest] end\n"    // external
-            "primitive [function] greaterp&greater? :thing1 :thing2 [:rest] end\n"          // external
-            // H
-            // I
-            "primitive [procedure control inline] if :boolean :if_true [:if_false void] 3 end\n"    // inline
-            "primitive [procedure control inline] ifelse :boolean :if_true :if_false end\n" // inline
-            "primitive [procedure control inline] iffalse&iff :if_false end\n"              // inline
-            "primitive [procedure control inline] iftrue&ift :if_true end\n"                // inline
-            "primitive [procedure] ignore :thing [:rest] end\n"                             // inline (special)
-            "primitive [function] int :number end\n"                                        // external
-            "primitive [function] integerp&integer? :thing end\n"                           // external
-            "primitive [function] item :number :thing end\n"                                // external
-            // J
-            // K
-            "primitive [function] keyp&key? end\n"                                          // MISSING
-            // L
-            "primitive [function] last :thing end last\n"                                   // external
-            "primitive [function] lastbyte :word end lastbyte\n"                            // external
-            "primitive [function] lessequalp&lessequal? :thing1 :thing2 [:rest] end\n"      // external
-            "primitive [function] lessp&less? :thing1 :thing2 [:rest] end\n"                // external
-            "primitive [function] list :thing [:rest] 2 end\n"                              // external
-            "primitive [function] listp&list? :thing end\n"                                 // external
-            "primitive [procedure] local :name [:rest] end\n"                               // external
-            "primitive [procedure] localmake :name :thing end\n"                            // external
-            "primitive [function] lowercase :word end lowercase\n"                          // external
-            "primitive [function] lput :item :thing end lput\n"                             // external
-            "primitive [function arithmetic] lshift :number :shift end lshift\n"            // external
-            // M
-            "primitive [procedure] make :name :thing end\n"                                 // external
-            "primitive [function] mditem :positions :list end\n"                            // external
-            "primitive [function] mdsetitem :positions :list :value end\n"                  // external
-            "primitive [function] member :thing1 :thing2 end\n"                             // external
-            "primitive [function] memberp&member? :thing1 :thing2 end\n"                    // external
-            "primitive [function arithmetic] minus :number end\n"                           // external
-            "primitive [function arithmetic] modulo :number1 :number2 end\n"                // external
-            // N
-            "primitive [procedure] name :thing :name end\n"                                 // external
-            "primitive [function] namedp&named? :name end\n"                                // external
-            "primitive [function] names end\n"                                              // external
-            "primitive [function arithmetic] nanp&nan? :number end\n"                       // external
-            "primitive [function] not :boolean end\n"                                       // external
-            "primitive [function] notequalp&notequal? :thing1 :thing2 [:rest] end\n"        // external
-            "primitive [procedure] notify :variable :procedure end\n"                       // external
-            "primitive [function] numberp&number? :thing end\n"                             // external
-            // O
-            "primitive [procedure] openappend :filename end\n"                              // external
-            "primitive [procedure] openread :filename end\n"                                // external
-            "primitive [procedure] openupdate :filename end\n"                              // external
-            "primitive [procedure] openwrite :filename end\n"                               // external
-            "primitive [function logic] or :boolean1 :boolean2 [:rest] end\n"               // external
-            "primitive [procedure control inline] output&op :thing end\n"                   // inline
-            // P
-            "primitive [function] pick :thing end\n"                                        // external
-            "primitive [function] plist :plistname end plist\n"                             // external
-            "primitive [function] plistp&plist? :plistname end plistp\n"                    // external
-            "primitive [function] plists end plists\n"                                      // external
-            "primitive [function arithmetic] plus :number end\n"                            // external
-            "primitive [function] pop :stack end\n"                                         // external
-            "primitive [procedure] pprop :plistname :propname :value end pprop\n"           // external
-            "primitive [function] prefix end\n"                                             // external
-            "primitive [function] primitivep&primitive? :name end\n"                        // external
-            "primitive [function] primitives end\n"                                         // external
-            "primitive [procedure] print&pr :thing [:rest] end\n"                           // external
-            "primitive [function] procedurep&procedure? :name end\n"                        // external
-            "primitive [function] procedures end\n"                                         // external
-            "primitive [function arithmetic] product :number1 :number2 [:rest] end\n"       // external
-            "primitive [procedure] push :stack :thing end\n"                                // external
-            // Q
-            "primitive [procedure] queue :queue :thing end\n"                               // external
-            "primitive [function] quoted :thing end quoted\n"                               // external
-            "primitive [function arithmetic] quotient :number1 :number2 [:rest] end\n"      // external
-            // R
-            "primitive [function arithmetic] radarccos :number1 end\n"                      // external
-            "primitive [function arithmetic] radarctan :number1 [:number2] end\n"           // external
-            "primitive [function arithmetic] radarcsin :number1 end\n"                      // external
-            "primitive [function arithmetic] radcos :number1 end\n"                         // external
-            "primitive [function arithmetic] radsin :number1 end\n"                         // external
-            "primitive [function arithmetic] radtan :number1 end\n"                         // external
-            "primitive [function] random :number [:rest] end\n"                             // external
-            "primitive [function] readbyte [:filename \"] end readbyte\n"                   // external
-            "primitive [function] readbytes :number [:filename \"] end readbytes\n"         // external
-            "primitive [function] readchar&rc [:filename \"] end readchar\n"                // external
-            "primitive [function] readchars&rcs :number [:filename \"] end readchars\n"     // external
-            "primitive [function] reader end reader\n"                                      // external
-            "primitive [function] readlist&rl [:filename \"] end readlist\n"                // external
-            "primitive [function] readpos [:filename \"] end readpos\n"                     // external
-            "primitive [function] readrawline [:filename \"] end readrawline\n"             // external
-            "primitive [function] readword&rw end\n"                                        // external
-            "primitive [function arithmetic] remainder :number1 :number2 end\n"             // external
-            "primitive [function] remdup :list end remdup\n"                                // external
-            "primitive [function] remove :thing :list end\n"                                // external
-            "primitive [procedure] remprop :plistname :propname end remprop\n"              // external
-            "primitive [function] repcount end\n"                                           // external
-            "primitive [procedure control inline] repeat :number :instructions end\n"       // inline
-            "primitive [function] rerandom [:rest] end\n"                                   // external
-            "primitive [function] reverse :thing end\n"                                     // external
-            // S
-            "primitive [function] sentence&se :thing [:rest] 2 end\n"                       // external
-            "primitive [procedure] setcursor :position end\n"                               // external
-            "primitive [function] setitem :position :list :value end\n"                     // external
-            "primitive [procedure] setprefix :prefix end setprefix\n"                       // external
-            "primitive [procedure] setread :filename end setread\n"                         // external
-            "primitive [procedure] setreadpos :number [:filename \"] end setreadpos\n"      // external
-            "primitive [procedure] settextcolor :foreground :background end\n"              // external
-            "primitive [procedure] setwrite :filename end setwrite\n"                       // external
-            "primitive [procedure] setwritepos :number [:filename \"] end setwritepos\n"    // external
-            "primitive [function] shell :command [:wordflag] end\n"                         // external
-            "primitive [procedure] show :thing [:rest] end\n"                               // external
-            "primitive [function arithmetic] sin :number1 end\n"                            // external
-            "primitive [function arithmetic] sqrt :number end\n"                            // external
-            "primitive [procedure] standout :thing [:rest] end\n"                           // external
-            "primitive [procedure control inline] stop end\n"                               // inline
-            "primitive [function] substringp&substring? :thing1 :thing2 end\n"              // external
-            "primitive [function arithmetic] sum :number1 :number2 [:rest] end\n"           // external
-            // T
-            "primitive [procedure control inline] tag :tag end\n"                           // inline
-            "primitive [function arithmetic] tan :number1 end\n"                            // external
-            "primitive [procedure] test :boolean end\n"                                     // external
-            "primitive [function inline] thing :name end\n"                                 // inline
-            "primitive [procedure control inline] throw :tag [:value void] 2 end\n"         // inline
-            "primitive [function] time end\n"                                               // external
-            "primitive [procedure] trace :list end\n"                                       // external
-            "primitive [function] tracedp&traced? :list end\n"                              // external
-            "primitive [function] ttyp&tty? end ttyp\n"                                     // external
-            "primitive [procedure] type :thing [:rest] end\n"                               // external
-            // U
-            "primitive [function] unicode :word end unicode\n"                              // external
-            "primitive [procedure] unnotify :variable [:procedure \"] 2 end unnotify\n"     // external
-            "primitive [function arithmetic] unorderedp&unordered? :thing1 :thing2 end\n"   // external
-            "primitive [procedure control inline] until :boolean :if_false end\n"           // inline
-            "primitive [procedure] untrace :list end\n"                                     // external
-            "primitive [function] uppercase :word end uppercase\n"                          // external
-            // V
-            // W
-            "primitive [procedure inline] wait :seconds end wait\n"                         // inline
-            "primitive [procedure control inline] while :boolean :if_true end while\n"      // inline
-            "primitive [function] word :word1 :word2 [:rest] end word\n"                    // external
-            "primitive [function] wordp&word? :thing end wordp\n"                           // external
-            "primitive [procedure] write :filename :data end write\n"                       // external
-            "primitive [function] writepos [:filename \"] end writepos\n"                   // external
-            "primitive [function] writer end writer\n"                                      // external
-            // X
-            "primitive [function logic] xor :boolean1 :boolean2 [:rest] end xor\n"          // external
-            // Y
-            // Z
-
-            // this is part of the run-time context
-            //
-            //"make \"caseignoredp true\n"
-            //"make \"printdepthlimit 0\n"
-            //"make \"printwidthlimit 0\n"
-        ));
 }
 
 
@@ -272,7 +88,14 @@ Parser::~Parser()
 {
     if(!f_keep_l_cpp)
     {
-        unlink("l.cpp");
+        for(auto const & source : f_sources)
+        {
+            unlink(source.c_str());
+        }
+        if(!f_scratch_dir.empty())
+        {
+            rmdir(f_scratch_dir.c_str());
+        }
     }
 }
 
@@ -313,6 +136,155 @@ void Parser::add_lexer(Lexer::pointer_t lexer)
 }
 
 
+/** \brief Declare the primitives.
+ *
+ * The primitives are defined in primitives.def. This function creates
+ * the same declarations as procedure() would create when reading
+ * `PRIMITIVE [flags] name :required [:optional default] [:rest] END`
+ * without having to lex and parse that text on each run.
+ *
+ * The default values are left as a list of tokens and get parsed by
+ * parse_declarations() like the defaults of any other declaration.
+ */
+void Parser::declare_primitives()
+{
+    std::string const filename("primitives.def");
+
+    for(auto const & primitive : g_primitive_declarations)
+    {
+        procedure_flag_t procedure_flags(PROCEDURE_FLAG_PRIMITIVE);
+        if((primitive.f_flags & PRIMITIVE_FUNCTION) != 0)
+        {
+            procedure_flags |= PROCEDURE_FLAG_FUNCTION;
+        }
+        if((primitive.f_flags & PRIMITIVE_ARITHMETIC) != 0)
+        {
+            procedure_flags |= PROCEDURE_FLAG_ARITHMETIC;
+        }
+        if((primitive.f_flags & PRIMITIVE_CONTROL) != 0)
+        {
+            procedure_flags |= PROCEDURE_FLAG_CONTROL | PROCEDURE_FLAG_INLINE;
+        }
+        if((primitive.f_flags & PRIMITIVE_INLINE) != 0)
+        {
+            procedure_flags |= PROCEDURE_FLAG_INLINE;
+        }
+        if((primitive.f_flags & PRIMITIVE_ARGUMENTS) != 0)
+        {
+            procedure_flags |= PROCEDURE_FLAG_ARGUMENTS;
+        }
+
+        Token::pointer_t name(make_token(token_t::TOK_WORD, filename));
+        name->set_word(token_t::TOK_WORD
+                     , primitive.f_alias == nullptr
+                            ? std::string(primitive.f_name)
+                            : std::string(primitive.f_name) + "&" + primitive.f_alias);
+
+        Token::pointer_t required_arguments(make_token(token_t::TOK_LIST, filename));
+        Token::pointer_t optional_arguments(make_token(token_t::TOK_LIST, filename));
+        Token::pointer_t rest_argument;
+
+        string_list_t words;
+        boost::split(words, primitive.f_arguments, boost::is_any_of(" "), boost::token_compress_on);
+        for(auto w(words.cbegin()); w != words.cend(); ++w)
+        {
+            if(w->empty())
+            {
+                continue;
+            }
+
+            // `:name`, `[:name` followed by the default value or `[:name]`
+            //
+            std::string thing_name(*w);
+            bool const list(thing_name[0] == '[');
+            bool const rest(list && thing_name.back() == ']');
+            if(rest)
+            {
+                thing_name.pop_back();
+            }
+            thing_name.erase(0, list ? 2 : 1);
+
+            Token::pointer_t thing(make_token(token_t::TOK_THING, filename));
+            thing->set_word(token_t::TOK_THING, thing_name);
+            if(!list)
+            {
+                required_arguments->add_list_item(thing);
+            }
+            else if(rest)
+            {
+                rest_argument = thing;
+            }
+            else
+            {
+                // the default values are simple words, create the
+                // tokens the lexer would create for them
+                //
+                Token::pointer_t expr(make_token(token_t::TOK_LIST, filename));
+                for(++w; w != words.cend(); ++w)
+                {
+                    bool const end(w->back() == ']');
+                    std::string const value(end ? w->substr(0, w->length() - 1) : *w);
+                    Token::pointer_t t(make_token(token_t::TOK_EOF, filename));
+                    if(value == "\"")
+                    {
+                        t->set_word(token_t::TOK_QUOTED, std::string());
+                    }
+                    else if(value == "true"
+                         || value == "false")
+                    {
+                        t->set_boolean(value == "true");
+                    }
+                    else if(value == "void")
+                    {
+                        t->set_token(token_t::TOK_VOID);
+                    }
+                    else
+                    {
+                        t->set_word(token_t::TOK_WORD, value);
+                    }
+                    expr->add_list_item(t);
+                    if(end)
+                    {
+                        break;
+                    }
+                }
+
+                Token::pointer_t default_arguments(make_token(token_t::TOK_LIST, filename));
+                default_arguments->add_list_item(thing);
+                default_arguments->add_list_item(expr);
+                optional_arguments->add_list_item(default_arguments);
+            }
+        }
+
+        primitive_arguments_t const count(primitive_count_arguments(primitive.f_arguments));
+        argument_count_t const min_args(count.f_required);
+        argument_count_t const def_args(primitive.f_default_args < 0
+                                            ? min_args
+                                            : static_cast<argument_count_t>(primitive.f_default_args));
+        argument_count_t const max_args(count.f_rest
+                                            ? std::numeric_limits<argument_count_t>::max()
+                                            : min_args + count.f_optional);
+
+        Token::pointer_t declaration(make_token(token_t::TOK_LIST, filename));
+        declaration->add_list_item(name);
+        declaration->add_list_item(required_arguments);
+        declaration->add_list_item(optional_arguments);
+        if(rest_argument != nullptr)
+        {
+            declaration->add_list_item(rest_argument);
+        }
+        declaration->set_function_limits(min_args, def_args, max_args);
+        declaration->set_procedure_flags(procedure_flags);
+
+        f_declarations->add_map_item(primitive.f_name, declaration);
+        if(primitive.f_alias != nullptr)
+        {
+            f_declarations->add_map_item(primitive.f_alias, declaration);
+        }
+    }
+}
+
+
 /** \brief Parse the input file.
  *
  * This function reads the input file by repeatitively calling the
@@ -433,7 +405,7 @@ void Parser::add_lexer(Lexer::pointer_t lexer)
  */
 void Parser::parse()    // => "start: ..."
 {
-    if(f_lexer.size() <= 1)
+    if(f_lexer.empty())
     {
         throw lpp_error("at least one input file is required.");
     }
@@ -442,7 +414,7 @@ void Parser::parse()    // => "start: ..."
     // programs and procedures since we need a complete list of all
     // the procedures and declarations before we can do so
     //
-    input_lines();
+    read_inputs();
 
     // now we can go ahead and verify the contents of the procedures
     // and program if one is defined
@@ -464,7 +436,7 @@ Token::pointer_t Parser::next_lexer_token()
     {
         if(f_lexer_pos >= f_lexer.size())
         {
-            f_current_token = std::make_shared<Token>(token_t::TOK_EOF);
+            f_current_token = make_token(token_t::TOK_EOF);
             break;
         }
 
@@ -480,6 +452,94 @@ Token::pointer_t Parser::next_lexer_token()
 }
 
 
+/** \brief Read all the input files.
+ *
+ * Each file is lexed and split in declarations, procedures and program
+ * by its own reader so the files are read in parallel. The results are
+ * then merged in the order the files were specified so a procedure
+ * defined in a later file replaces one with the same name defined in
+ * an earlier file, as when the files get read one after the other.
+ */
+void Parser::read_inputs()
+{
+    std::size_t const count(f_lexer.size());
+    if(count == 1)
+    {
+        input_lines();
+        return;
+    }
+    std::size_t const max_threads(std::min(count, std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1))));
+
+    std::vector<std::unique_ptr<Parser>> readers;
+    readers.reserve(count);
+    for(auto const & lexer : f_lexer)
+    {
+        readers.emplace_back(new Parser(lexer, f_output_object));
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> next(0);
+    auto read = [&readers, &errors, &next, count]()
+        {
+            for(;;)
+            {
+                std::size_t const idx(next++);
+                if(idx >= count)
+                {
+                    return;
+                }
+                try
+                {
+                    readers[idx]->input_lines();
+                }
+                catch(...)
+                {
+                    errors[idx] = std::current_exception();
+                }
+            }
+        };
+
+    std::vector<std::thread> threads;
+    for(std::size_t idx(1); idx < max_threads; ++idx)
+    {
+        threads.emplace_back(read);
+    }
+    read();
+    for(auto & t : threads)
+    {
+        t.join();
+    }
+
+    for(std::size_t idx(0); idx < count; ++idx)
+    {
+        if(errors[idx] != nullptr)
+        {
+            std::rethrow_exception(errors[idx]);
+        }
+
+        Parser const & reader(*readers[idx]);
+        for(auto const & d : reader.f_declarations->get_map())
+        {
+            f_declarations->add_map_item(d.first, d.second);
+        }
+        for(auto const & p : reader.f_procedures->get_map())
+        {
+            f_procedures->add_map_item(p.first, p.second);
+        }
+        if(reader.f_program->get_list_size() > 0)
+        {
+            if(f_program->get_list_size() > 0)
+            {
+                reader.f_program->get_list_item(0)->error("You can have at most one program in your logo files.");
+                return;
+            }
+            f_program = reader.f_program;
+        }
+    }
+    f_lexer_pos = count;
+}
+
+
 void Parser::input_lines()
 {
     next_lexer_token();
@@ -589,6 +649,16 @@ void Parser::procedure(Token::pointer_t keyword)
                         {
                             procedure_flags |= PROCEDURE_FLAG_ARITHMETIC;
                         }
+                        else if(flag_name == "arguments")
+                        {
+                            if((procedure_flags & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PRIMITIVE)
+                            {
+                                f_current_token->error("the \"arguments\" flag can only be used with primitives.");
+                                return;
+                            }
+
+                            procedure_flags |= PROCEDURE_FLAG_ARGUMENTS;
+                        }
                         break;
 
                     case 'c':
@@ -718,7 +788,7 @@ void Parser::procedure(Token::pointer_t keyword)
     // TO WORD thing_list
     //         ^
     //
-    Token::pointer_t required_arguments(std::make_shared<Token>(token_t::TOK_LIST));
+    Token::pointer_t required_arguments(make_token(token_t::TOK_LIST));
 
     argument_count_t min_args(0);
     Token::pointer_t arg;
@@ -754,7 +824,7 @@ void Parser::procedure(Token::pointer_t keyword)
     // TO WORD thing_list optional_thing_list
     //                    ^
     //
-    Token::pointer_t optional_arguments(std::make_shared<Token>(token_t::TOK_LIST));
+    Token::pointer_t optional_arguments(make_token(token_t::TOK_LIST));
 
     Token::pointer_t rest_argument;
 
@@ -802,7 +872,7 @@ void Parser::procedure(Token::pointer_t keyword)
         //                     ^
         //
         //Token::pointer_t expr(expression()); -- defaults can't be parsed now
-        Token::pointer_t expr(std::make_shared<Token>(token_t::TOK_LIST, f_current_token));
+        Token::pointer_t expr(make_token(token_t::TOK_LIST, f_current_token));
         std::uint_fast32_t count(1);
         for(;;)
         {
@@ -841,7 +911,7 @@ void Parser::procedure(Token::pointer_t keyword)
             t = next_lexer_token();
         }
 
-        Token::pointer_t default_arguments(std::make_shared<Token>(token_t::TOK_LIST));
+        Token::pointer_t default_arguments(make_token(token_t::TOK_LIST));
         default_arguments->add_list_item(arg);
         default_arguments->add_list_item(expr);
 
@@ -900,7 +970,7 @@ std::cerr << to_string(keyword->get_token())
         next_lexer_token();
     }
 
-    Token::pointer_t declaration(std::make_shared<Token>(token_t::TOK_LIST));
+    Token::pointer_t declaration(make_token(token_t::TOK_LIST));
     declaration->add_list_item(name);
     declaration->add_list_item(required_arguments);
     declaration->add_list_item(optional_arguments);
@@ -945,7 +1015,7 @@ std::cerr << to_string(keyword->get_token())
         // read tokens up to END
         //
 
-        Token::pointer_t body(std::make_shared<Token>());
+        Token::pointer_t body(make_token());
         body->set_token(token_t::TOK_LIST);
         declaration->add_list_item(body);
 
@@ -1124,7 +1194,7 @@ Token::pointer_t Parser::next_body_token()
 
     if(f_body_pos >= f_body->get_list_size())
     {
-        f_current_token = std::make_shared<Token>(token_t::TOK_EOF);
+        f_current_token = make_token(token_t::TOK_EOF);
     }
     else
     {
@@ -1213,7 +1283,7 @@ Token::pointer_t Parser::parse_body(Token::pointer_t body)
     f_body_pos = 0;
     f_body = body;
 
-    Token::pointer_t new_body(std::make_shared<Token>(token_t::TOK_LIST));
+    Token::pointer_t new_body(make_token(token_t::TOK_LIST));
     next_body_token();
     for(;;)
     {
@@ -1481,7 +1551,7 @@ Token::pointer_t Parser::equality_expression()
                 next_body_token();
                 Token::pointer_t rhs(relational_expression());
 
-                Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, lhs));
+                Token::pointer_t op(make_token(token_t::TOK_EOF, lhs));
                 std::string const function_name(boost::to_lower_copy(to_string(token)));
                 op->set_word(token_t::TOK_FUNCTION_CALL, function_name);
                 op->set_declaration(f_declarations->get_map_item(function_name));
@@ -1517,7 +1587,7 @@ Token::pointer_t Parser::relational_expression()
                 next_body_token();
                 Token::pointer_t rhs(additive_expression());
 
-                Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, lhs));
+                Token::pointer_t op(make_token(token_t::TOK_EOF, lhs));
                 std::string const function_name(boost::to_lower_copy(to_string(token)));
                 op->set_word(token_t::TOK_FUNCTION_CALL, function_name);
                 op->set_declaration(f_declarations->get_map_item(function_name));
@@ -1551,7 +1621,7 @@ Token::pointer_t Parser::additive_expression()
                 next_body_token();
                 Token::pointer_t rhs(multiplicative_expression());
 
-                Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, lhs));
+                Token::pointer_t op(make_token(token_t::TOK_EOF, lhs));
                 std::string const function_name(boost::to_lower_copy(to_string(token)));
                 op->set_word(token_t::TOK_FUNCTION_CALL, function_name);
                 op->set_declaration(f_declarations->get_map_item(function_name));
@@ -1585,7 +1655,7 @@ Token::pointer_t Parser::multiplicative_expression()
                 next_body_token();
                 Token::pointer_t rhs(unary_expression());
 
-                Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, lhs));
+                Token::pointer_t op(make_token(token_t::TOK_EOF, lhs));
                 std::string const function_name(boost::to_lower_copy(to_string(token)));
                 op->set_word(token_t::TOK_FUNCTION_CALL, function_name);
                 op->set_declaration(f_declarations->get_map_item(function_name));
@@ -1625,7 +1695,7 @@ Token::pointer_t Parser::unary_expression()
             next_body_token();
             Token::pointer_t rhs(unary_expression());
 
-            Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, rhs));
+            Token::pointer_t op(make_token(token_t::TOK_EOF, rhs));
             op->set_word(token_t::TOK_FUNCTION_CALL, "plus");
             op->set_declaration(f_declarations->get_map_item("plus"));
             op->add_list_item(rhs);
@@ -1638,7 +1708,7 @@ Token::pointer_t Parser::unary_expression()
             next_body_token();
             Token::pointer_t rhs(unary_expression());
 
-            Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, rhs));
+            Token::pointer_t op(make_token(token_t::TOK_EOF, rhs));
             op->set_word(token_t::TOK_FUNCTION_CALL, "minus");
             op->set_declaration(f_declarations->get_map_item("minus"));
             op->add_list_item(rhs);
@@ -1651,7 +1721,7 @@ Token::pointer_t Parser::unary_expression()
             next_body_token();
             Token::pointer_t rhs(unary_expression());
 
-            Token::pointer_t op(std::make_shared<Token>(token_t::TOK_EOF, rhs));
+            Token::pointer_t op(make_token(token_t::TOK_EOF, rhs));
             op->set_word(token_t::TOK_FUNCTION_CALL, "count");
             op->set_declaration(f_declarations->get_map_item("count"));
             op->add_list_item(rhs);
@@ -1691,7 +1761,7 @@ Token::pointer_t Parser::unary_expression()
     case token_t::TOK_OPEN_LIST:
         {
             ++f_parsing_list;
-            Token::pointer_t list(std::make_shared<Token>(token_t::TOK_LIST, f_current_token));
+            Token::pointer_t list(make_token(token_t::TOK_LIST, f_current_token));
 
             next_body_token();
             for(;;)
@@ -1743,13 +1813,13 @@ Token::pointer_t Parser::unary_expression()
                              + ":"
                              + f_current_token->get_word()
                              + ") an expression");
-        return std::make_shared<Token>(token_t::TOK_VOID);
+        return make_token(token_t::TOK_VOID);
 
     default:
         f_current_token->error("unexpected token ("
                              + to_string(f_current_token->get_token())
                              + ") for an expression");
-        return std::make_shared<Token>(token_t::TOK_VOID);
+        return make_token(token_t::TOK_VOID);
 
     }
 }
@@ -1757,73 +1827,58 @@ Token::pointer_t Parser::unary_expression()
 
 
 
-void Parser::optimize()
-{
-    // TODO: go through all the function calls in the procedures and program
-    //       and optimize those that we can optimize (i.e. `SUM 3 7` becomes
-    //       `10`)
-    //
-    //       note that at first this may not look useful for basic
-    //       arithmetics since the C++ compiler will take care of
-    //       such optimizations, but if you end up with an instruction
-    //       such as `item 3 [a b c d e f]` you can reduce it to just `c`
-    //       which is something the C++ compiler is not likely to do for us
-}
-
-
+/** \brief Generate the C++ code.
+ *
+ * Each procedure is written in its own translation unit (l-<name>.cpp)
+ * and the registration of the procedures and the program go to l.cpp.
+ * A unit only depends on the procedure it defines so the compiler can
+ * reuse the object of a procedure which did not change since the last
+ * build (see Compiler::compile()).
+ */
 void Parser::generate()
 {
-    class auto_close
-    {
-    public:
-        auto_close(std::ofstream & stream)
-            : f_stream(stream)
-        {
-        }
+    f_sources.clear();
 
-        ~auto_close()
+    // the intermediate files go to a private directory so multiple
+    // lpp can run in parallel in the same directory; with --keep-l-cpp
+    // the user wants to look at them so they stay in the current
+    // directory
+    //
+    if(!f_keep_l_cpp
+    && f_scratch_dir.empty())
+    {
+        char const * tmpdir(getenv("TMPDIR"));
+        std::string pattern(tmpdir == nullptr || *tmpdir == '\0' ? "/tmp" : tmpdir);
+        pattern += "/lpp-XXXXXX";
+        if(mkdtemp(&pattern[0]) == nullptr)
         {
-            f_stream.close();
+            f_current_token->error("unable to create a temporary directory for the intermediate files.");
+            return;
         }
-
-    private:
-        std::ofstream &     f_stream;
-    };
-
-    auto_close out_stream(f_out);
-
-    f_out.open("l.cpp");
-    if(!f_out.is_open())
-    {
-        f_current_token->error("unable to open intermediate file \"l.cpp\".");
-        return;
+        f_scratch_dir = pattern;
     }
 
-    f_out << "// AUTO-GENERATED FILE\n"
-          << "#include <lpp/lpp.hpp>\n";
+    auto const & procedures(f_procedures->get_map());
 
     {
-        f_out << "// Function Declarations\n";
-
-        auto const & procedures(f_procedures->get_map());
-        for(auto p : procedures)
-        {
-            std::string const cpp_name(logo_to_cpp_name(p.first));
-            f_out << "void procedure_" << cpp_name << "(lpp::lpp__context::pointer_t);\n";
-        }
-    }
+        start_unit();
 
-    {
         f_out << "// Function Registration\n"
                  "namespace\n"
-                 "{\n"
-                 "lpp::lpp__procedure_info_t const lpp__procedures[]{\n";
+                 "{\n";
+
+        // the layout of the arguments is necessary for CALL and NOTIFY
+        //
+        f_out << "lpp::lpp__procedure_info_t const lpp__procedures[]{\n";
 
-        auto const & procedures(f_procedures->get_map());
+        string_list_t names;
         for(auto p : procedures)
         {
             Token::pointer_t declaration(f_declarations->get_map_item(p.first));
             std::string const cpp_name(logo_to_cpp_name(p.first));
+            names.push_back(cpp_name);
+            std::size_t const slot_count(get_argument_names(declaration).size());
+            f_called_procedures[cpp_name] = declaration;
             f_out << "{\""
                   << cpp_name
                   << "\",procedure_"
@@ -1836,102 +1891,442 @@ void Parser::generate()
                   << declaration->get_max_args()
                   << "UL,"
                      "lpp::PROCEDURE_FLAG_PROCEDURE"
-                  << ((declaration->get_procedure_flags() & PROCEDURE_FLAG_FUNCTION) != 0 ? "|lpp::PROCEDURE_FLAG_FUNCTION" : "")
-                  << "},\n";
+                  << ((declaration->get_procedure_flags() & PROCEDURE_FLAG_FUNCTION) != 0 ? "|lpp::PROCEDURE_FLAG_FUNCTION" : "");
+            if(slot_count > 0)
+            {
+                f_out << ","
+                      << get_slot_table(declaration)
+                      << ","
+                      << slot_count;
+            }
+            f_out << "},\n";
+        }
+
+        f_out << "};\n";
+
+        // the run time searches the procedures by name with a perfect
+        // hash so it does not have to build a map on startup
+        //
+        std::size_t const size(perfect_hash_size(names.size()));
+        std::vector<std::uint32_t> seeds(size);
+        std::vector<std::uint32_t> slots(size);
+        std::vector<std::uint32_t> buckets(names.size());
+        if(!perfect_hash_build(
+                  names.size()
+                , [&names](std::size_t idx) { return names[idx].c_str(); }
+                , seeds
+                , slots
+                , buckets))
+        {
+            throw std::logic_error("no perfect hash found for the procedures.");
         }
+        auto output_table = [this](char const * name, std::vector<std::uint32_t> const & table)
+            {
+                f_out << "std::uint32_t const "
+                      << name
+                      << "[]{";
+                char const * sep("");
+                for(auto const v : table)
+                {
+                    f_out << sep
+                          << v
+                          << "U";
+                    sep = ",";
+                }
+                f_out << "};\n";
+            };
+        output_table("lpp__procedure_seeds", seeds);
+        output_table("lpp__procedure_slots", slots);
 
-        f_out << "};\n"
-                 "lpp::lpp__auto_register_procedures lpp__procs(lpp__procedures,"
+        f_out << "lpp::lpp__auto_register_procedures lpp__procs(lpp__procedures,"
               << procedures.size()
+              << ",lpp__procedure_seeds,lpp__procedure_slots,"
+              << size
               << ");\n"
                  "}\n";
+
+        f_has_program = f_program->get_list_size() > 0;
+        if(f_has_program)
+        {
+            f_out << "// Program Definition\n";
+
+            f_function.reset();
+            f_argument_slots.clear();
+            f_local_slots.clear();
+
+            f_out << "void lpp__startup(lpp::lpp__context::pointer_t context)\n"
+                     "{\n";
+            output_body(f_program);
+            f_out << "}\n";
+        }
+
+        write_unit("l.cpp");
     }
 
+    for(auto p : procedures)
     {
-        f_out << "// Function Definitions\n";
+        start_unit();
 
-        auto const & procedures(f_procedures->get_map());
-        for(auto p : procedures)
-        {
-            auto const max(p.second->get_list_size());
+        auto const max(p.second->get_list_size());
 
-            f_function = p.second;
+        f_function = p.second;
 
-            std::string const cpp_name(logo_to_cpp_name(p.first));
-            f_out << "void procedure_"
-                  << cpp_name
-                  << "(lpp::lpp__context::pointer_t context)\n"
-                     "{\n";
+        // resolve the parameters and local variables to slots
+        //
+        Token::pointer_t declaration(f_declarations->get_map_item(p.first));
+        f_argument_slots.clear();
+        f_local_slots.clear();
+        string_list_t const names(get_argument_names(declaration));
+        for(std::size_t idx(0); idx < names.size(); ++idx)
+        {
+            f_argument_slots[names[idx]] = idx;
+        }
+        find_local_variables(p.second->get_list_item(max - 1));
 
-            if(f_enable_trace)
-            {
-                f_out << "context->trace_procedure(lpp::trace_mode_t::TRACE_MODE_ENTER,lpp::lpp__value::pointer_t());\n";
-            }
+        std::string const cpp_name(logo_to_cpp_name(p.first));
+        procedure_flag_t const procedure_flags(declaration->get_procedure_flags());
+        bool const function((procedure_flags & PROCEDURE_FLAG_FUNCTION) != 0);
+        f_out << "// Function Definition\n"
+                 "namespace\n"
+                 "{\n"
+                 "lpp::lpp__value::pointer_t lpp__body(lpp::lpp__context::pointer_t context)\n"
+                 "{\n";
 
-            output_body(p.second->get_list_item(max - 1));
+        // tail calls jump back here; the locals get destroyed and created
+        // again by the jump (tracing keeps the real calls so the CALL and
+        // RETURN messages stay balanced)
+        //
+        f_tail_calls = !f_enable_trace
+                    && has_self_call(p.second->get_list_item(max - 1));
+        if(f_tail_calls)
+        {
+            f_out << "lpp__tail_call:;\n";
+        }
 
-            // a procedure must OUTPUT <expr> and never reached the END
-            //
-            // TODO: detect this problem at compile time (which is definitely
-            //       doable...) and avoid this throw
-            //
-            Token::pointer_t declaration(f_declarations->get_map_item(p.first));
-            procedure_flag_t const procedure_flags(declaration->get_procedure_flags());
-            if((procedure_flags & PROCEDURE_FLAG_FUNCTION) != 0)
+        if(!f_local_slots.empty())
+        {
+            string_list_t local_names(f_local_slots.size());
+            for(auto const & l : f_local_slots)
             {
-                f_out << "context->end_of_function_reached();\n";
+                local_names[l.second] = l.first;
             }
-            else if(f_enable_trace)
+            f_out << "static lpp::lpp__atom_t const lpp__local_names[]{";
+            char const * sep("");
+            for(auto const & n : local_names)
             {
-                f_out << "context->trace_procedure(lpp::trace_mode_t::TRACE_MODE_EXIT,lpp::lpp__value::pointer_t());\n";
+                f_out << sep
+                      << get_atom(n);
+                sep = ",";
             }
+            f_out << "};\n"
+                     "lpp::lpp__locals<"
+                  << local_names.size()
+                  << "> lpp__locals(context,lpp__local_names);\n";
+        }
 
-            f_out << "}\n";
+        if(f_enable_trace)
+        {
+            f_out << "context->trace_procedure(lpp::trace_mode_t::TRACE_MODE_ENTER,lpp::lpp__value::pointer_t());\n";
         }
-    }
 
-    f_has_program = f_program->get_list_size() > 0;
-    if(f_has_program)
-    {
-        f_out << "// Program Definition\n";
+        output_body(p.second->get_list_item(max - 1), true);
+        f_tail_calls = false;
+
+        // a procedure must OUTPUT <expr> and never reached the END
+        //
+        // TODO: detect this problem at compile time (which is definitely
+        //       doable...) and avoid this throw
+        //
+        if(function)
+        {
+            f_out << "context->end_of_function_reached();\n";
+        }
+        else
+        {
+            if(f_enable_trace)
+            {
+                f_out << "context->trace_procedure(lpp::trace_mode_t::TRACE_MODE_EXIT,lpp::lpp__value::pointer_t());\n";
+            }
+            f_out << "return lpp::lpp__value::pointer_t();\n";
+        }
 
-        f_function.reset();
+        f_out << "}\n"
+                 "}\n";
 
-        f_out << "void lpp__startup(lpp::lpp__context::pointer_t context)\n"
+        // the other procedures call this function directly: it creates
+        // the frame from the arguments and returns the OUTPUT value
+        //
+        std::size_t const slot_count(names.size());
+        f_out << get_procedure_signature(cpp_name, slot_count)
+              << "\n"
                  "{\n";
-        output_body(f_program);
-        f_out << "}\n";
+        if(slot_count > 0)
+        {
+            f_out << "lpp::lpp__frame<"
+                  << slot_count
+                  << "> context("
+                  << get_slot_table(declaration)
+                  << ",";
+        }
+        else
+        {
+            f_out << "lpp::lpp__context context(";
+        }
+        f_out << "filename,\""
+              << cpp_name
+              << "\",line,false);\n";
+        for(std::size_t idx(0); idx < slot_count; ++idx)
+        {
+            f_out << "context.get_slot("
+                  << idx
+                  << ").set_value(lpp__a"
+                  << idx
+                  << ",lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
+        }
+        f_out << "context.attach(parent);\n"
+                 "return lpp__body(&context);\n"
+                 "}\n";
+
+        // CALL, NOTIFY, etc. go through the table of procedures which
+        // uses this function, the caller prepared the frame
+        //
+        f_out << "void procedure_"
+              << cpp_name
+              << "(lpp::lpp__context::pointer_t context)\n"
+                 "{\n"
+                 "context->set_return_value(lpp__body(context));\n"
+                 "}\n";
+
+        write_unit("l-" + cpp_name + ".cpp");
     }
 }
 
 
-bool Parser::has_program() const
+/** \brief Get ready to generate a new translation unit.
+ */
+void Parser::start_unit()
 {
-    return f_has_program;
-}
+    f_out.str(std::string());
 
+    // float literals (possibly computed by optimize()) must not lose
+    // any precision on their way to the C++ code
+    //
+    f_out.precision(std::numeric_limits<float_t>::max_digits10);
 
-void Parser::output_body(Token::pointer_t body)
-{
-    auto const max(body->get_list_size());
-    for(std::remove_const<decltype(max)>::type c(0); c < max; ++c)
-    {
-        // a body is a list of commands (function calls)
-        //
-        output_function_call(body->get_list_item(c));
-    }
+    // the temporary names are local to the unit; restarting them makes
+    // the text of a unit independent from the units generated before
+    // it so its cached object remains valid
+    //
+    f_unique = 0;
+    f_atoms.clear();
+    f_slot_tables.clear();
+    f_constants.clear();
+    f_constant_definitions.clear();
+    f_called_procedures.clear();
 }
 
 
-void Parser::output_function_call(Token::pointer_t function_call, std::string const & result_var)
+/** \brief Save the current translation unit.
+ *
+ * The atoms, argument layouts, literals and procedure declarations are
+ * only known once the whole unit was generated, so they get written
+ * ahead of the code.
+ *
+ * \param[in] name  The name of the file to create.
+ */
+void Parser::write_unit(std::string const & name)
 {
-    // a command may have a list of arguments following it
-    //
-    auto const max_args(function_call->get_list_size());
-    Token::pointer_t declaration(function_call->get_declaration());
-    if(declaration == nullptr)
+    std::string const filename(f_scratch_dir.empty() ? name : f_scratch_dir + "/" + name);
+    std::ofstream out(filename);
+    if(!out.is_open())
     {
-        throw std::logic_error("somehow a function_call has a declaration pointer set to nullptr.");
+        f_current_token->error("unable to open intermediate file \"" + filename + "\".");
+        return;
+    }
+    f_sources.push_back(filename);
+
+    out << "// AUTO-GENERATED FILE\n"
+           "#include <lpp/lpp.hpp>\n"
+           "// Function Declarations\n";
+    for(auto const & p : f_called_procedures)
+    {
+        out << "void procedure_" << p.first << "(lpp::lpp__context::pointer_t);\n"
+            << get_procedure_signature(p.first, get_argument_names(p.second).size()) << ";\n";
+    }
+    out << "// Atoms\n"
+           "namespace\n"
+           "{\n";
+    for(auto const & a : f_atoms)
+    {
+        out << "lpp::lpp__atom_t const lpp__atom_"
+            << logo_to_cpp_name(a)
+            << "(lpp::lpp__intern("
+            << word_to_cpp_string_literal(a)
+            << "));\n";
+    }
+    for(auto const & t : f_slot_tables)
+    {
+        out << "lpp::lpp__atom_t const lpp__slots_"
+            << t.first
+            << "[]{";
+        char const * sep("");
+        for(auto const & n : get_argument_names(t.second))
+        {
+            out << sep
+                << "lpp__atom_"
+                << logo_to_cpp_name(n);
+            sep = ",";
+        }
+        out << "};\n";
+    }
+    out << "// Literals\n";
+    for(auto const & c : f_constant_definitions)
+    {
+        out << c;
+    }
+    out << "}\n"
+        << f_out.str();
+}
+
+
+string_list_t const & Parser::get_sources() const
+{
+    return f_sources;
+}
+
+
+bool Parser::has_program() const
+{
+    return f_has_program;
+}
+
+
+void Parser::output_body(Token::pointer_t body, bool tail_position)
+{
+    auto const max(body->get_list_size());
+    for(std::remove_const<decltype(max)>::type c(0); c < max; ++c)
+    {
+        // the last command of a body in tail position is in tail position
+        // and so is a command followed by STOP
+        //
+        f_tail_position = f_tail_calls
+                       && f_catch_depth == 0
+                       && ((tail_position && c + 1 == max)
+                           || (c + 1 < max
+                               && body->get_list_item(c + 1)->get_token() == token_t::TOK_FUNCTION_CALL
+                               && body->get_list_item(c + 1)->get_word() == "stop"));
+
+        // a body is a list of commands (function calls)
+        //
+        output_function_call(body->get_list_item(c));
+    }
+    f_tail_position = false;
+}
+
+
+/** \brief Check whether \p call is a call to the procedure being generated.
+ *
+ * \param[in] call  A TOK_FUNCTION_CALL token.
+ *
+ * \return true if \p call calls f_function.
+ */
+bool Parser::is_self_call(Token::pointer_t call)
+{
+    return f_function != nullptr
+        && call->get_declaration() == f_function;
+}
+
+
+/** \brief Check whether a procedure may call itself.
+ *
+ * The lists of instructions of the control primitives are only parsed
+ * when the code gets generated so this function also checks the words
+ * of such lists.
+ *
+ * \param[in] list  The body of the procedure or one of its lists.
+ *
+ * \return true if the procedure being generated appears in \p list.
+ */
+bool Parser::has_self_call(Token::pointer_t list)
+{
+    std::size_t const max(list->get_list_size());
+    for(std::size_t idx(0); idx < max; ++idx)
+    {
+        Token::pointer_t const & item(list->get_list_item(idx));
+        switch(item->get_token())
+        {
+        case token_t::TOK_LIST:
+            if(has_self_call(item))
+            {
+                return true;
+            }
+            break;
+
+        case token_t::TOK_FUNCTION_CALL:
+            if(is_self_call(item)
+            || has_self_call(item))
+            {
+                return true;
+            }
+            break;
+
+        case token_t::TOK_WORD:
+            if(f_procedures->get_map_item(item->get_word()) == f_function)
+            {
+                return true;
+            }
+            break;
+
+        default:
+            break;
+
+        }
+    }
+
+    return false;
+}
+
+
+/** \brief Replace a call to the procedure being generated with a jump.
+ *
+ * When a procedure calls itself as the last thing it does, the current
+ * frame is not needed anymore so the new arguments are saved in it and
+ * the code jumps back to the start of the procedure instead of growing
+ * the stack with a new frame. The arguments were all computed before
+ * this function gets called since they may use the current values.
+ *
+ * \param[in] slot_values  The values of each argument slot.
+ */
+void Parser::output_tail_call(string_list_t const & slot_values)
+{
+    f_out << "context->restart();\n";
+    for(std::size_t idx(0); idx < slot_values.size(); ++idx)
+    {
+        f_out << "context->get_slot("
+              << idx
+              << ").set_value("
+              << slot_values[idx]
+              << ",lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
+    }
+    f_out << "goto lpp__tail_call;\n";
+}
+
+
+void Parser::output_function_call(Token::pointer_t function_call, std::string const & result_var)
+{
+    // only this call may be in tail position, not the calls computing
+    // its arguments
+    //
+    bool const tail_position(f_tail_position);
+    f_tail_position = false;
+
+    // a command may have a list of arguments following it
+    //
+    auto const max_args(function_call->get_list_size());
+    Token::pointer_t declaration(function_call->get_declaration());
+    if(declaration == nullptr)
+    {
+        throw std::logic_error("somehow a function_call has a declaration pointer set to nullptr.");
     }
     procedure_flag_t const procedure_flags(declaration->get_procedure_flags());
 
@@ -1943,48 +2338,54 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
 
     if((procedure_flags & PROCEDURE_FLAG_CONTROL) != 0)
     {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
         control_t control_info = {
-            .f_function_call    = function_call,
-            .f_result_var       = result_var,
-            .f_max_args         = max_args,
-            .f_declaration      = declaration,
-            .f_procedure_flags  = procedure_flags
+            function_call,      // f_function_call
+            result_var,         // f_result_var
+            max_args,           // f_max_args
+            declaration,        // f_declaration
+            procedure_flags,    // f_procedure_flags
+            tail_position       // f_tail_position
         };
-#pragma GCC diagnostic pop
 
         control_primitive(control_info);
     }
     else
     {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
         control_t control_info = {
-            .f_function_call    = function_call,
-            .f_result_var       = result_var,
-            .f_max_args         = max_args,
-            .f_declaration      = declaration,
-            .f_procedure_flags  = procedure_flags
+            function_call,      // f_function_call
+            result_var,         // f_result_var
+            max_args,           // f_max_args
+            declaration,        // f_declaration
+            procedure_flags,    // f_procedure_flags
+            tail_position       // f_tail_position
         };
-#pragma GCC diagnostic pop
 
         if(!inline_primitive(control_info))
         {
             std::string const context_name(get_unique_name());
+            bool const ignore(declaration->get_word() == "ignore");
 
-            f_out << "{\n"
-                     "lpp::lpp__context::pointer_t "
-                  << context_name
-                  << "(std::make_shared<lpp::lpp__context>(\""
-                  << function_call->get_filename()
-                  << "\",\""
-                  << logo_to_cpp_name(function_call->get_word())
-                  << "\","
-                  << function_call->get_line()
-                  << ","
-                  << ((procedure_flags & PROCEDURE_FLAG_TYPE_MASK) == PROCEDURE_FLAG_PRIMITIVE ? "true" : "false")
-                  << "));\n";
+            // a call to itself in tail position (the last command or
+            // the value of OUTPUT) becomes a jump
+            //
+            bool const tail_call(tail_position
+                              && is_self_call(function_call)
+                              && (!result_var.empty()
+                                  || (f_function->get_procedure_flags() & PROCEDURE_FLAG_FUNCTION) == 0));
+
+            // user procedures get their arguments as C++ parameters and
+            // create their own frame; the primitives get a frame
+            //
+            bool const direct(!ignore
+                           && ((procedure_flags & PROCEDURE_FLAG_TYPE_MASK) == PROCEDURE_FLAG_PROCEDURE
+                               || (procedure_flags & PROCEDURE_FLAG_TYPE_MASK) == PROCEDURE_FLAG_DECLARE));
+
+            // some primitives get their arguments (rest included) in an
+            // array instead of named slots
+            //
+            bool const arguments(!ignore
+                              && (procedure_flags & PROCEDURE_FLAG_ARGUMENTS) != 0);
+            string_list_t slot_values;
 
             Token::pointer_t required_arguments(declaration->get_list_item(1));
             Token::pointer_t optional_arguments(declaration->get_list_item(2));
@@ -1995,17 +2396,60 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                 || declaration->get_list_size() >= 5)
                 {
                     rest_argument = declaration->get_list_item(3);
+                }
+            }
 
-                    f_out << "lpp::lpp__value::vector_t rest;\n";
-                    auto const reserve(max_args - required_arguments->get_list_size() - optional_arguments->get_list_size());
-                    if(reserve > 0)
-                    {
-                        f_out << "rest.reserve("
-                              << std::min(std::max(static_cast<decltype(reserve)>(0)
-                                                 , reserve)
-                                        , static_cast<decltype(reserve)>(20))
-                              << ");\n";
-                    }
+            f_out << "{\n";
+
+            // the frame of the callee lives on the stack; its arguments
+            // are saved in slots in the order of the declaration
+            //
+            auto const slot_count(required_arguments->get_list_size()
+                                + optional_arguments->get_list_size()
+                                + (rest_argument != nullptr ? 1 : 0));
+            if(!ignore
+            && !direct
+            && !arguments)
+            {
+                if(slot_count > 0)
+                {
+                    f_out << "lpp::lpp__frame<"
+                          << slot_count
+                          << "> "
+                          << context_name
+                          << "("
+                          << get_slot_table(declaration)
+                          << ",";
+                }
+                else
+                {
+                    f_out << "lpp::lpp__context "
+                          << context_name
+                          << "(";
+                }
+                f_out << "\""
+                      << function_call->get_filename()
+                      << "\",\""
+                      << logo_to_cpp_name(function_call->get_word())
+                      << "\","
+                      << function_call->get_line()
+                      << ","
+                      << ((procedure_flags & PROCEDURE_FLAG_TYPE_MASK) == PROCEDURE_FLAG_PRIMITIVE ? "true" : "false")
+                      << ");\n";
+            }
+
+            if(rest_argument != nullptr
+            && !arguments)
+            {
+                f_out << "lpp::lpp__value::vector_t rest;\n";
+                auto const reserve(max_args - required_arguments->get_list_size() - optional_arguments->get_list_size());
+                if(reserve > 0)
+                {
+                    f_out << "rest.reserve("
+                          << std::min(std::max(static_cast<std::remove_const<decltype(reserve)>::type>(0)
+                                             , reserve)
+                                    , static_cast<std::remove_const<decltype(reserve)>::type>(20))
+                          << ");\n";
                 }
             }
 
@@ -2039,15 +2483,21 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                 }
                 // else -- accumulate in the rest list
 
-                if(declaration->get_word() != "ignore")
+                if(!ignore)
                 {
                     if(arg_name != nullptr)
                     {
 //std::cerr << "    -> set param \"" << arg_name->get_word() << "\"\n";
+                        if(direct
+                        || arguments)
+                        {
+                            slot_values.push_back(value_name);
+                            continue;
+                        }
                         f_out << context_name
-                              << "->set_thing("
-                              << word_to_cpp_string_literal(arg_name->get_word())
-                              << ","
+                              << ".get_slot("
+                              << a
+                              << ").set_value("
                               << value_name
                               << ",lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
                     }
@@ -2063,6 +2513,11 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                         }
 
                         // add to rest list
+                        if(arguments)
+                        {
+                            slot_values.push_back(value_name);
+                            continue;
+                        }
                         f_out << "rest.push_back("
                               << value_name
                               << ");\n";
@@ -2070,10 +2525,12 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                 }
             }
 
-            if(declaration->get_word() != "ignore")
+            if(!ignore
+            && !direct
+            && !arguments)
             {
                 f_out << context_name
-                      << "->attach(context);\n";
+                      << ".attach(context);\n";
             }
 
             decltype(max_args) max_opt(required_arguments->get_list_size() + optional_arguments->get_list_size());
@@ -2086,25 +2543,67 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                 std::string const value_name(get_unique_name());
                 output_argument(opt_arg->get_list_item(1), value_name);
 
-                if(declaration->get_word() != "ignore")
+                if(direct
+                || arguments)
+                {
+                    slot_values.push_back(value_name);
+                }
+                else if(!ignore)
                 {
                     f_out << context_name
-                          << "->set_thing("
-                          << word_to_cpp_string_literal(arg_name->get_word())
-                          << ","
+                          << ".get_slot("
+                          << a
+                          << ").set_value("
                           << value_name
                           << ",lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
                 }
             }
 
-            if(declaration->get_word() != "ignore")
+            if(direct)
+            {
+                if(rest_argument != nullptr)
+                {
+                    slot_values.push_back("lpp::lpp__make_value(rest)");
+                }
+                if(tail_call)
+                {
+                    output_tail_call(slot_values);
+                }
+                else
+                {
+                    std::string const cpp_name(logo_to_cpp_name(declaration->get_word()));
+                    f_called_procedures[cpp_name] = declaration;
+                    if(!result_var.empty())
+                    {
+                        f_out << result_var
+                              << "=";
+                    }
+                    f_out << "procedure_"
+                          << cpp_name
+                          << "(context,\""
+                          << function_call->get_filename()
+                          << "\","
+                          << function_call->get_line();
+                    for(auto const & v : slot_values)
+                    {
+                        f_out << ","
+                              << v;
+                    }
+                    f_out << ");\n";
+                }
+            }
+            else if(arguments)
+            {
+                output_primitive_call(function_call, slot_values, result_var);
+            }
+            else if(!ignore)
             {
                 if(rest_argument != nullptr)
                 {
                     f_out << context_name
-                          << "->set_thing("
-                          << word_to_cpp_string_literal(rest_argument->get_word())
-                          << ",std::make_shared<lpp::lpp__value>(rest),lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
+                          << ".get_slot("
+                          << slot_count - 1
+                          << ").set_value(lpp::lpp__make_value(rest),lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
                 }
 
                 switch(procedure_flags & PROCEDURE_FLAG_TYPE_MASK)
@@ -2113,18 +2612,13 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                     f_out << "primitive_";
                     break;
 
-                case PROCEDURE_FLAG_PROCEDURE:
-                case PROCEDURE_FLAG_DECLARE:
-                    f_out << "procedure_";
-                    break;
-
                 case PROCEDURE_FLAG_C:  // C functions are called as is
                     break;
 
                 }
 //std::cerr << "    -> call func. \"" << declaration->get_word() << "\"\n";
                 f_out << logo_to_cpp_name(declaration->get_word())
-                      << "("
+                      << "(&"
                       << context_name
                       << ");\n";
 
@@ -2133,7 +2627,7 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
                     f_out << result_var
                           << "="
                           << context_name
-                          << "->get_returned_value();\n";
+                          << ".get_returned_value();\n";
                 }
             }
 
@@ -2143,6 +2637,122 @@ void Parser::output_function_call(Token::pointer_t function_call, std::string co
 }
 
 
+/** \brief Call a primitive with values which were already computed.
+ *
+ * The primitives with the PROCEDURE_FLAG_ARGUMENTS flag get the values
+ * in an array, rest included. The others get a frame with the values
+ * saved in their slots and an empty :REST.
+ *
+ * The inline primitives also use this function when the value they
+ * were given is not handled inline so the primitive computes the
+ * result or raises the error exactly as when it is called normally.
+ *
+ * \param[in] function_call  The call to the primitive.
+ * \param[in] values  The names of the variables holding the values.
+ * \param[in] result_var  The variable receiving the result, if any.
+ */
+void Parser::output_primitive_call(Token::pointer_t function_call, string_list_t const & values, std::string const & result_var)
+{
+    Token::pointer_t declaration(function_call->get_declaration());
+    bool const arguments((declaration->get_procedure_flags() & PROCEDURE_FLAG_ARGUMENTS) != 0);
+    auto const slot_count(get_argument_names(declaration).size());
+    std::string const context_name(get_unique_name());
+
+    if(arguments
+    || slot_count == 0)
+    {
+        f_out << "lpp::lpp__context "
+              << context_name
+              << "(";
+    }
+    else
+    {
+        f_out << "lpp::lpp__frame<"
+              << slot_count
+              << "> "
+              << context_name
+              << "("
+              << get_slot_table(declaration)
+              << ",";
+    }
+    f_out << "\""
+          << function_call->get_filename()
+          << "\",\""
+          << logo_to_cpp_name(function_call->get_word())
+          << "\","
+          << function_call->get_line()
+          << ",true);\n";
+
+    std::string args("nullptr");
+    if(arguments)
+    {
+        if(!values.empty())
+        {
+            args = get_unique_name();
+            f_out << "lpp::lpp__value::pointer_t const "
+                  << args
+                  << "[]{";
+            char const * sep("");
+            for(auto const & v : values)
+            {
+                f_out << sep
+                      << v;
+                sep = ",";
+            }
+            f_out << "};\n";
+        }
+    }
+    else
+    {
+        for(std::size_t idx(0); idx < slot_count; ++idx)
+        {
+            f_out << context_name
+                  << ".get_slot("
+                  << idx
+                  << ").set_value("
+                  << (idx < values.size() ? values[idx] : "lpp::lpp__make_value(lpp::lpp__value::vector_t())")
+                  << ",lpp::lpp__thing_type_t::LPP__THING_TYPE_CONTEXT);\n";
+        }
+    }
+
+    f_out << context_name
+          << ".attach(context);\n";
+
+    if(arguments)
+    {
+        if(!result_var.empty())
+        {
+            f_out << result_var
+                  << "=";
+        }
+        f_out << "primitive_"
+              << logo_to_cpp_name(declaration->get_word())
+              << "(&"
+              << context_name
+              << ","
+              << args
+              << ","
+              << values.size()
+              << ");\n";
+    }
+    else
+    {
+        f_out << "primitive_"
+              << logo_to_cpp_name(declaration->get_word())
+              << "(&"
+              << context_name
+              << ");\n";
+        if(!result_var.empty())
+        {
+            f_out << result_var
+                  << "="
+                  << context_name
+                  << ".get_returned_value();\n";
+        }
+    }
+}
+
+
 void Parser::output_argument(Token::pointer_t arg, std::string const & value_name)
 {
     switch(arg->get_token())
@@ -2157,72 +2767,31 @@ void Parser::output_argument(Token::pointer_t arg, std::string const & value_nam
         break;
 
     case token_t::TOK_BOOLEAN:
-        f_out << "lpp::lpp__value::pointer_t "
-              << value_name
-              << "(std::make_shared<lpp::lpp__value>("
-              << (arg->get_boolean() ? "true" : "false")
-              << "));\n";
-        break;
-
     case token_t::TOK_INTEGER:
-        f_out << "lpp::lpp__value::pointer_t "
-              << value_name
-              << "(std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>("
-              << arg->get_integer()
-              << "LL)));\n";
-        break;
-
     case token_t::TOK_FLOAT:
-        f_out << "lpp::lpp__value::pointer_t "
-              << value_name
-              << "(std::make_shared<lpp::lpp__value>(";
-        if(std::isnan(arg->get_float()))
-        {
-            f_out  << "std::numeric_limits<lpp::lpp__float_t>::quiet_NaN()";
-        }
-        else
-        {
-            f_out << arg->get_float();
-        }
-        f_out << "));\n";
-        break;
-
     case token_t::TOK_WORD:
-        f_out << "lpp::lpp__value::pointer_t "
-              << value_name
-              << "(std::make_shared<lpp::lpp__value>("
-                 "std::string("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")"
-                 ")"
-                 ");\n";
-        break;
-
     case token_t::TOK_QUOTED:
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(std::make_shared<lpp::lpp__value>("
-                 "std::string("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")"
-                 ")"
-                 ");\n";
+              << "("
+              << get_literal(arg)
+              << ");\n";
         break;
 
     case token_t::TOK_THING:
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(context->get_thing("
-              << word_to_cpp_string_literal(arg->get_word())
-              << ")->get_value());\n";
+              << "("
+              << get_thing_value(arg->get_word())
+              << ");\n";
         break;
 
     case token_t::TOK_LIST:
         f_out << "lpp::lpp__value::pointer_t "
               << value_name
-              << "(";
-        build_list(arg);
-        f_out << ");\n";
+              << "("
+              << build_list(arg)
+              << ");\n";
         break;
 
     default:
@@ -2236,88 +2805,74 @@ void Parser::output_argument(Token::pointer_t arg, std::string const & value_nam
 
 
 
-void Parser::build_list(Token::pointer_t list)
+/** \brief Get the constant representing a literal list.
+ *
+ * Literal lists are built once when the program starts and shared
+ * by all the executions of the code using them.
+ *
+ * \param[in] list  The list to transform in a constant.
+ *
+ * \return The name of the constant.
+ */
+std::string Parser::build_list(Token::pointer_t list)
 {
-    f_out << "std::make_shared<lpp::lpp__value>(lpp::lpp__value::vector_t{\n";
-    build_list_content(list);
-    f_out << "})\n";
+    std::string items;
+    build_list_content(list, items);
+    return get_constant("lpp::lpp__make_constant(lpp::lpp__value::vector_t{" + items + "})");
 }
 
 
-void Parser::build_list_content(Token::pointer_t list)
+void Parser::build_list_content(Token::pointer_t list, std::string & items)
 {
     auto const max(list->get_list_size());
     for(std::remove_const<decltype(max)>::type l(0); l < max; ++l)
     {
-        if(l != 0)
-        {
-            f_out << ",";
-        }
-        build_list_item(list->get_list_item(l));
+        build_list_item(list->get_list_item(l), items);
     }
 }
 
 
-void Parser::build_list_item(Token::pointer_t item)
+void Parser::build_list_item(Token::pointer_t item, std::string & items)
 {
+    if(!items.empty())
+    {
+        items += ",";
+    }
+
     switch(item->get_token())
     {
     case token_t::TOK_BOOLEAN:
-        f_out << "std::make_shared<lpp::lpp__value>("
-              << item->get_boolean()
-              << ")\n";
-        break;
-
     case token_t::TOK_INTEGER:
-        f_out << "std::make_shared<lpp::lpp__value>(static_cast<lpp::lpp__integer_t>("
-              << item->get_integer()
-              << "LL))\n";
-        break;
-
     case token_t::TOK_FLOAT:
-        f_out << "std::make_shared<lpp::lpp__value>("
-              << item->get_float()
-              << ")\n";
+    case token_t::TOK_WORD:
+    case token_t::TOK_QUOTED:
+        items += get_literal(item);
         break;
 
     case token_t::TOK_THING:
-        f_out << "std::make_shared<lpp::lpp__value>(':' + std::string("
-              << word_to_cpp_string_literal(item->get_word())
-              << "))\n";
-        break;
-
-    case token_t::TOK_WORD:
-    case token_t::TOK_QUOTED:
-        f_out << "std::make_shared<lpp::lpp__value>(std::string("
-              << word_to_cpp_string_literal(item->get_word())
-              << "))\n";
+        items += get_constant("lpp::lpp__make_constant(std::string("
+                            + word_to_cpp_string_literal(':' + item->get_word())
+                            + "))");
         break;
 
     case token_t::TOK_FUNCTION_CALL:    // TODO: operators get transformed in this way...
         {
-            f_out << "std::make_shared<lpp::lpp__value>(std::string("
-                  << word_to_cpp_string_literal(item->get_word())
-                  << "))\n";
+            items += get_constant("lpp::lpp__make_constant(std::string("
+                                + word_to_cpp_string_literal(item->get_word())
+                                + "))");
             auto const fcmax(item->get_list_size());
             if(fcmax > 0)
             {
                 // TODO: write the list items, not the list itself
                 // (especially for the :rest parameter)
                 //
-                //for(std::remove_const<decltype(fcmax)>::type fc(0); fc < fcmax; ++fc)
-                //{
-                //    f_out << ",";
-                //    build_list(item->get_list_item(fc));
-                //}
-
-                f_out << ",";
-                build_list_content(item);
+                build_list_content(item, items);
             }
         }
         break;
 
     case token_t::TOK_LIST:
-        build_list(item);
+        items += build_list(item);
         break;
 
     default:
@@ -2401,6 +2956,325 @@ std::string Parser::get_unique_name()
 }
 
 
+/** \brief Get the names of the argument slots of a procedure.
+ *
+ * The frame of a call saves the arguments in slots. The slots are
+ * ordered as in the declaration: the required arguments, then the
+ * optional arguments, and finally the rest argument if any.
+ *
+ * \param[in] declaration  The declaration of the procedure.
+ *
+ * \return The list of names, one per slot.
+ */
+string_list_t Parser::get_argument_names(Token::pointer_t declaration)
+{
+    string_list_t names;
+
+    Token::pointer_t required_arguments(declaration->get_list_item(1));
+    for(std::size_t idx(0); idx < required_arguments->get_list_size(); ++idx)
+    {
+        names.push_back(required_arguments->get_list_item(idx)->get_word());
+    }
+
+    Token::pointer_t optional_arguments(declaration->get_list_item(2));
+    for(std::size_t idx(0); idx < optional_arguments->get_list_size(); ++idx)
+    {
+        names.push_back(optional_arguments->get_list_item(idx)->get_list_item(0)->get_word());
+    }
+
+    // procedures have their body as the last item
+    //
+    if(declaration->get_list_size() >= 4)
+    {
+        if((declaration->get_procedure_flags() & PROCEDURE_FLAG_TYPE_MASK) != PROCEDURE_FLAG_PROCEDURE
+        || declaration->get_list_size() >= 5)
+        {
+            names.push_back(declaration->get_list_item(3)->get_word());
+        }
+    }
+
+    return names;
+}
+
+
+/** \brief Search for the LOCAL and LOCALMAKE variables of a procedure.
+ *
+ * This function goes through the body of a procedure and adds the
+ * name of each variable created with a literal name by LOCAL or
+ * LOCALMAKE to the f_local_slots map. The counters of the FOR loops
+ * are saved in the procedure context too so they also get a slot.
+ *
+ * The lists of instructions (i.e. the body of an IF or REPEAT) are
+ * not yet parsed so there we search for the "local" or "localmake"
+ * word followed by a quoted word and the "for" word followed by its
+ * control list.
+ *
+ * Finding a name which in the end is not a variable (i.e. a list
+ * of data which looks like a LOCAL command) is harmless; that slot
+ * never gets declared so it is never visible.
+ *
+ * \param[in] list  The list of tokens to search.
+ */
+void Parser::find_local_variables(Token::pointer_t list)
+{
+    auto const max(list->get_list_size());
+    for(std::remove_const<decltype(max)>::type idx(0); idx < max; ++idx)
+    {
+        Token::pointer_t item(list->get_list_item(idx));
+        switch(item->get_token())
+        {
+        case token_t::TOK_FUNCTION_CALL:
+            if(item->get_word() == "local"
+            || item->get_word() == "localmake")
+            {
+                auto const arg_max(item->get_word() == "local" ? item->get_list_size() : 1);
+                for(std::remove_const<decltype(arg_max)>::type a(0); a < arg_max && a < item->get_list_size(); ++a)
+                {
+                    Token::pointer_t arg(item->get_list_item(a));
+                    if(arg->get_token() == token_t::TOK_LIST)
+                    {
+                        for(std::size_t l(0); l < arg->get_list_size(); ++l)
+                        {
+                            add_local_variable(arg->get_list_item(l));
+                        }
+                    }
+                    else
+                    {
+                        add_local_variable(arg);
+                    }
+                }
+            }
+            else if(item->get_word() == "for"
+                 && item->get_list_size() > 0)
+            {
+                add_for_variable(item->get_list_item(0));
+            }
+            find_local_variables(item);
+            break;
+
+        case token_t::TOK_WORD:
+            if((item->get_word() == "local"
+             || item->get_word() == "localmake")
+            && idx + 1 < max)
+            {
+                add_local_variable(list->get_list_item(idx + 1));
+            }
+            else if(item->get_word() == "for"
+                 && idx + 1 < max)
+            {
+                add_for_variable(list->get_list_item(idx + 1));
+            }
+            break;
+
+        case token_t::TOK_LIST:
+            find_local_variables(item);
+            break;
+
+        default:
+            break;
+
+        }
+    }
+}
+
+
+void Parser::add_for_variable(Token::pointer_t control)
+{
+    if(control->get_token() == token_t::TOK_LIST
+    && control->get_list_size() > 0)
+    {
+        add_local_variable(control->get_list_item(0));
+    }
+}
+
+
+void Parser::add_local_variable(Token::pointer_t name)
+{
+    if(name->get_token() != token_t::TOK_QUOTED
+    && name->get_token() != token_t::TOK_WORD)
+    {
+        return;
+    }
+
+    std::string const word(name->get_word());
+    if(f_argument_slots.find(word) != f_argument_slots.end()
+    || f_local_slots.find(word) != f_local_slots.end())
+    {
+        return;
+    }
+
+    std::size_t const idx(f_local_slots.size());
+    f_local_slots[word] = idx;
+}
+
+
+/** \brief Generate the C++ expression returning the value of a thing.
+ *
+ * The parameters and the local variables of the procedure being
+ * generated are accessed directly through their slot. Any other
+ * variable is searched by name using the dynamic scope.
+ *
+ * The counter of a FOR loop which nothing else can see lives in a C++
+ * variable; only reading it as a value creates an lpp__value.
+ *
+ * \param[in] name  The name of the thing.
+ *
+ * \return The C++ expression returning an lpp::lpp__value::pointer_t.
+ */
+std::string Parser::get_thing_value(std::string const & name)
+{
+    auto const native(f_native_things.find(name));
+    if(native != f_native_things.end())
+    {
+        return "lpp::lpp__make_value(" + native->second.f_expression + ")";
+    }
+
+    auto const arg(f_argument_slots.find(name));
+    if(arg != f_argument_slots.end())
+    {
+        return "context->get_slot_value(" + std::to_string(arg->second) + ")";
+    }
+
+    auto const local(f_local_slots.find(name));
+    if(local != f_local_slots.end())
+    {
+        return "context->get_local_value(" + std::to_string(local->second) + ")";
+    }
+
+    return "context->get_thing(" + get_atom(name) + ")->get_value()";
+}
+
+
+std::string Parser::get_atom(std::string const & name)
+{
+    f_atoms.insert(name);
+    return "lpp__atom_" + logo_to_cpp_name(name);
+}
+
+
+/** \brief Get the constant representing a literal.
+ *
+ * \param[in] literal  A boolean, number or word token.
+ *
+ * \return The name of the constant holding that literal.
+ */
+std::string Parser::get_literal(Token::pointer_t literal)
+{
+    std::stringstream initializer;
+    initializer << "lpp::lpp__make_constant(";
+    switch(literal->get_token())
+    {
+    case token_t::TOK_BOOLEAN:
+        initializer << (literal->get_boolean() ? "true" : "false");
+        break;
+
+    case token_t::TOK_INTEGER:
+        initializer << "static_cast<lpp::lpp__integer_t>("
+                    << literal->get_integer()
+                    << "LL)";
+        break;
+
+    case token_t::TOK_FLOAT:
+        if(std::isnan(literal->get_float()))
+        {
+            initializer << "std::numeric_limits<lpp::lpp__float_t>::quiet_NaN()";
+        }
+        else
+        {
+            initializer.precision(std::numeric_limits<float_t>::max_digits10);
+            initializer << "static_cast<lpp::lpp__float_t>("
+                        << literal->get_float()
+                        << ")";
+        }
+        break;
+
+    case token_t::TOK_WORD:
+    case token_t::TOK_QUOTED:
+        initializer << "std::string("
+                    << word_to_cpp_string_literal(literal->get_word())
+                    << ")";
+        break;
+
+    default:
+        throw std::logic_error("get_literal() called with an unsupported token.");
+
+    }
+    initializer << ")";
+
+    return get_constant(initializer.str());
+}
+
+
+/** \brief Get the name of a constant.
+ *
+ * The constants are written at the top of l.cpp and initialized once
+ * when the program starts. The same literal found in several places
+ * reuses the same constant.
+ *
+ * \param[in] initializer  The C++ expression creating the constant.
+ *
+ * \return The name of the constant.
+ */
+std::string Parser::get_constant(std::string const & initializer)
+{
+    auto const it(f_constants.find(initializer));
+    if(it != f_constants.end())
+    {
+        return it->second;
+    }
+
+    std::string const name("lpp__const_" + std::to_string(f_constants.size() + 1));
+    f_constants[initializer] = name;
+    f_constant_definitions.push_back(
+              "lpp::lpp__value::pointer_t const "
+            + name
+            + "("
+            + initializer
+            + ");\n");
+    return name;
+}
+
+
+std::string Parser::get_slot_table(Token::pointer_t declaration)
+{
+    std::string const cpp_name(logo_to_cpp_name(declaration->get_word()));
+    if(f_slot_tables.insert(slot_table_map_t::value_type(cpp_name, declaration)).second)
+    {
+        for(auto const & n : get_argument_names(declaration))
+        {
+            f_atoms.insert(n);
+        }
+    }
+    return "lpp__slots_" + cpp_name;
+}
+
+
+/** \brief Get the signature of the direct entry point of a procedure.
+ *
+ * The procedures call each other with their arguments as C++ parameters
+ * (required, optional, then the rest list) and get the OUTPUT value as
+ * the result of the call (a null pointer after a STOP). The filename
+ * and line of the call are used by the error messages.
+ *
+ * \param[in] cpp_name  The C++ name of the procedure.
+ * \param[in] slot_count  The number of arguments of the procedure.
+ *
+ * \return The signature, without the final semicolon.
+ */
+std::string Parser::get_procedure_signature(std::string const & cpp_name, std::size_t slot_count)
+{
+    std::string signature("lpp::lpp__value::pointer_t procedure_"
+                        + cpp_name
+                        + "(lpp::lpp__context::pointer_t parent,char const * filename,lpp::lpp__integer_t line");
+    for(std::size_t idx(0); idx < slot_count; ++idx)
+    {
+        signature += ",lpp::lpp__value::pointer_t lpp__a" + std::to_string(idx);
+    }
+    signature += ")";
+    return signature;
+}
+
+
 } // lpp namespace
 
 // vim: ts=4 sw=4 et nocindent
@@ -20,7 +20,8 @@
 
 #include "lexer.hpp"
 
-#include <fstream>
+#include <set>
+#include <sstream>
 
 
 
@@ -28,6 +29,31 @@ namespace lpp
 {
 
 
+typedef std::vector<std::string>                string_list_t;
+typedef std::map<std::string, std::size_t>      slot_map_t;
+typedef std::set<std::string>                   atom_set_t;
+typedef std::map<std::string, Token::pointer_t> slot_table_map_t;
+typedef std::map<std::string, std::string>      constant_map_t;
+
+
+// type of an expression which can be computed with native C++ numbers
+//
+enum class numeric_t
+{
+    NUMERIC_NONE,       // not a number or not known at compile time
+    NUMERIC_INTEGER,    // lpp__integer_t
+    NUMERIC_FLOAT       // lpp__float_t
+};
+
+struct native_thing_t
+{
+    std::string             f_expression = std::string();
+    numeric_t               f_type = numeric_t::NUMERIC_NONE;
+};
+
+typedef std::map<std::string, native_thing_t>   native_thing_map_t;
+
+
 class Parser
 {
 public:
@@ -48,6 +74,7 @@ public:
     void                    generate();
 
     bool                    has_program() const;
+    string_list_t const &   get_sources() const;
 
 private:
     struct control_t
@@ -57,8 +84,13 @@ private:
         Token::vector_t::size_type  f_max_args;
         Token::pointer_t            f_declaration;
         procedure_flag_t const      f_procedure_flags;
+        bool const                  f_tail_position;
     };
 
+                            Parser(Lexer::pointer_t lexer, bool output_object);
+
+    void                    declare_primitives();
+    void                    read_inputs();
     void                    parse_declarations();
     void                    parse_procedures();
     void                    parse_program();
@@ -77,17 +109,42 @@ private:
     Token::pointer_t        additive_expression();
     Token::pointer_t        multiplicative_expression();
     Token::pointer_t        unary_expression();
-    void                    output_body(Token::pointer_t body);
+    void                    start_unit();
+    void                    write_unit(std::string const & name);
+    void                    output_body(Token::pointer_t body, bool tail_position = false);
+    bool                    is_self_call(Token::pointer_t call);
+    bool                    has_self_call(Token::pointer_t list);
+    void                    output_tail_call(string_list_t const & slot_values);
     void                    output_function_call(Token::pointer_t function_call, std::string const & result_var = std::string());
+    void                    output_primitive_call(Token::pointer_t function_call, string_list_t const & values, std::string const & result_var);
     void                    output_argument(Token::pointer_t arg, std::string const & value_name);
-    void                    build_list(Token::pointer_t list);
-    void                    build_list_content(Token::pointer_t list);
-    void                    build_list_item(Token::pointer_t item);
+    std::string             build_list(Token::pointer_t list);
+    void                    build_list_content(Token::pointer_t list, std::string & items);
+    void                    build_list_item(Token::pointer_t item, std::string & items);
+    std::string             get_literal(Token::pointer_t literal);
+    std::string             get_constant(std::string const & initializer);
     void                    control_primitive(control_t & control_info);
     bool                    inline_primitive(control_t & control_info);
     std::string             logo_to_cpp_name(std::string const & name);
     std::string             word_to_cpp_string_literal(std::string const & word);
     std::string             get_unique_name();
+    string_list_t           get_argument_names(Token::pointer_t declaration);
+    void                    find_local_variables(Token::pointer_t list);
+    void                    add_for_variable(Token::pointer_t control);
+    void                    add_local_variable(Token::pointer_t name);
+    std::string             get_thing_value(std::string const & name);
+    std::string             get_atom(std::string const & name);
+    std::string             get_slot_table(Token::pointer_t declaration);
+    std::string             get_procedure_signature(std::string const & cpp_name, std::size_t slot_count);
+    numeric_t               get_numeric_type(Token::pointer_t expr);
+    std::string             native_expression(Token::pointer_t expr, numeric_t type);
+    bool                    is_native_boolean(Token::pointer_t expr);
+    std::string             output_boolean(Token::pointer_t expr);
+    bool                    is_native_counter_safe(Token::pointer_t list, std::string const & name);
+    Token::pointer_t        optimize_body(Token::pointer_t body);
+    void                    optimize_call(Token::pointer_t call);
+    bool                    is_terminator(Token::pointer_t item);
+    Token::pointer_t        fold_call(Token::pointer_t call);
 
     void                    control_call(control_t & control_info, bool function_call);
     void                    control_catch(control_t & control_info);
@@ -103,6 +160,15 @@ private:
     void                    control_throw(control_t & control_info);
     void                    control_while(control_t & control_info, bool until, bool once);
 
+    bool                    primitive_arithmetic(control_t & control_info);
+    bool                    primitive_butfirst(control_t & control_info);
+    bool                    primitive_count(control_t & control_info);
+    bool                    primitive_first(control_t & control_info, bool last);
+    bool                    primitive_item(control_t & control_info);
+    bool                    primitive_local(control_t & control_info);
+    bool                    primitive_make(control_t & control_info, int name_idx, bool local);
+    bool                    primitive_predicate(control_t & control_info);
+    bool                    primitive_put(control_t & control_info, bool last);
     void                    primitive_thing(control_t & control_info);
     void                    primitive_wait(control_t & control_info);
 
@@ -114,7 +180,14 @@ private:
     std::uint_fast32_t      f_body_pos = 0;
     Token::pointer_t        f_body = Token::pointer_t();
     Token::pointer_t        f_function = Token::pointer_t();
+    slot_map_t              f_argument_slots = slot_map_t();        // parameters of f_function
+    slot_map_t              f_local_slots = slot_map_t();           // LOCAL/LOCALMAKE of f_function
+    native_thing_map_t      f_native_things = native_thing_map_t(); // FOR counters readable as C++ numbers
+    bool                    f_tail_calls = false;                   // f_function may jump back to its start
+    bool                    f_tail_position = false;                // the next call is the last thing f_function does
+    std::uint_fast32_t      f_catch_depth = 0;
     std::uint_fast64_t      f_unique = 0;
+    std::size_t             f_folded = 0;
     std::uint_fast16_t      f_lexer_pos = 0;
     std::uint_fast32_t      f_parsing_list = 0;
     Lexer::vector_t         f_lexer = Lexer::vector_t();
@@ -122,7 +195,14 @@ private:
     Token::pointer_t        f_program = Token::pointer_t();         // PROGRAM ...
     Token::pointer_t        f_declarations = Token::pointer_t();    // DECLARE/PRIMITIVE ...
     Token::pointer_t        f_procedures = Token::pointer_t();      // TO ...
-    std::ofstream           f_out = std::ofstream();
+    atom_set_t              f_atoms = atom_set_t();                 // names used by the generated code
+    slot_table_map_t        f_slot_tables = slot_table_map_t();     // argument layouts used by the generated code
+    constant_map_t          f_constants = constant_map_t();         // initializer -> name of the literals
+    string_list_t           f_constant_definitions = string_list_t();   // literals in the order they were created
+    slot_table_map_t        f_called_procedures = slot_table_map_t();   // C++ name -> declaration of the procedures called by the unit
+    string_list_t           f_sources = string_list_t();            // the generated translation units
+    std::string             f_scratch_dir = std::string();          // private directory of the intermediate files
+    std::stringstream       f_out = std::stringstream();
 };
 
 
@@ -18,6 +18,9 @@
 
 #include "token.hpp"
 
+#include <mutex>
+#include <set>
+
 
 
 namespace lpp
@@ -72,6 +75,40 @@ char const * const g_token_to_string[] =
 #pragma GCC diagnostic pop
 
 
+// the tokens are allocated in blocks and released tokens are kept in
+// a free list; a compilation creates many small tokens which are then
+// contiguous in memory instead of scattered in the heap
+//
+constexpr std::size_t       TOKEN_BLOCK_SIZE = 1024;
+
+// the files are read in parallel, each thread has its own free list
+//
+thread_local void *         g_token_free_list = nullptr;
+
+
+// all the tokens of a file share the same filename string
+//
+std::mutex                  g_filenames_mutex = std::mutex();
+std::set<std::string>       g_filenames = std::set<std::string>();
+
+
+std::string const * intern_filename(std::string const & filename)
+{
+    // the lexer creates all the tokens of a file in a row
+    //
+    thread_local std::string const * g_last_filename = nullptr;
+    if(g_last_filename != nullptr
+    && *g_last_filename == filename)
+    {
+        return g_last_filename;
+    }
+
+    std::lock_guard<std::mutex> lock(g_filenames_mutex);
+    g_last_filename = &*g_filenames.insert(filename).first;
+    return g_last_filename;
+}
+
+
 
 } // no name namespace
 
@@ -95,7 +132,7 @@ std::string to_string(token_t token)
 
 Token::Token(token_t token, std::string const & filename, line_t line)
     : f_token(token)
-    , f_filename(filename)
+    , f_filename(intern_filename(filename))
     , f_line(line)
 {
 }
@@ -109,6 +146,40 @@ Token::Token(token_t token, Token::pointer_t location)
 }
 
 
+void * Token::operator new (std::size_t size)
+{
+    if(size != sizeof(Token))
+    {
+        throw std::logic_error("Token::operator new() called with an unexpected size.");
+    }
+
+    if(g_token_free_list == nullptr)
+    {
+        // the blocks are never released, the tokens they hold are
+        // recycled until the compiler exits
+        //
+        char * block(static_cast<char *>(::operator new(sizeof(Token) * TOKEN_BLOCK_SIZE)));
+        for(std::size_t idx(TOKEN_BLOCK_SIZE); idx > 0; --idx)
+        {
+            void * ptr(block + sizeof(Token) * (idx - 1));
+            *static_cast<void **>(ptr) = g_token_free_list;
+            g_token_free_list = ptr;
+        }
+    }
+
+    void * ptr(g_token_free_list);
+    g_token_free_list = *static_cast<void **>(ptr);
+    return ptr;
+}
+
+
+void Token::operator delete (void * ptr)
+{
+    *static_cast<void **>(ptr) = g_token_free_list;
+    g_token_free_list = ptr;
+}
+
+
 void Token::set_token(token_t token)
 {
     switch(token)
@@ -467,7 +538,7 @@ Token::vector_t::size_type Token::get_list_size() const
 }
 
 
-Token::pointer_t Token::get_list_item(vector_t::size_type idx) const
+Token::pointer_t const & Token::get_list_item(vector_t::size_type idx) const
 {
     switch(f_token)
     {
@@ -528,7 +599,7 @@ Token::pointer_t Token::get_map_item(std::string const & name) const
 
 std::string const & Token::get_filename() const
 {
-    return f_filename;
+    return *f_filename;
 }
 
 
@@ -540,7 +611,7 @@ line_t Token::get_line() const
 
 void Token::error(std::string const & message)
 {
-    throw lpp_error(message, f_filename, f_line);
+    throw lpp_error(message, *f_filename, f_line);
 }
 
 
@@ -20,6 +20,8 @@
 
 #include "exception.hpp"
 
+#include <boost/intrusive_ptr.hpp>
+
 #include <iostream>
 #include <map>
 #include <memory>
@@ -105,6 +107,7 @@ constexpr procedure_flag_t          PROCEDURE_FLAG_INLINE       = 0x00000010;
 constexpr procedure_flag_t          PROCEDURE_FLAG_ARITHMETIC   = 0x00000020;
 constexpr procedure_flag_t          PROCEDURE_FLAG_CONTROL      = 0x00000040;
 constexpr procedure_flag_t          PROCEDURE_FLAG_FUNCTION     = 0x00000080;       // function uses OUTPUT <expr>
+constexpr procedure_flag_t          PROCEDURE_FLAG_ARGUMENTS    = 0x00000100;       // primitive called with an array of arguments
 
 constexpr procedure_flag_t          PROCEDURE_FLAG_OPTIONAL_OPTION_PARSED = 0x80000000;       // function uses OUTPUT <expr>
 
@@ -118,12 +121,17 @@ typedef std::uint32_t               argument_count_t;
 class Token
 {
 public:
-    typedef std::shared_ptr<Token>              pointer_t;
+    typedef boost::intrusive_ptr<Token>         pointer_t;
     typedef std::vector<pointer_t>              vector_t;
     typedef std::map<std::string, pointer_t>    map_t;
 
                         Token(token_t token = token_t::TOK_EOF, std::string const & filename = std::string(), line_t line = 0);
                         Token(token_t token, Token::pointer_t location);
+                        Token(Token const & rhs) = delete;
+    Token &             operator = (Token const & rhs) = delete;
+
+    static void *       operator new (std::size_t size);
+    static void         operator delete (void * ptr);
 
     void                set_token(token_t token);
     void                set_word(token_t token, std::string const & word, bool start_of_line = false);
@@ -151,7 +159,7 @@ public:
     argument_count_t    get_max_args() const;
     pointer_t           get_declaration() const;
     vector_t::size_type get_list_size() const;
-    pointer_t           get_list_item(vector_t::size_type idx) const;
+    pointer_t const &   get_list_item(vector_t::size_type idx) const;
     map_t const &       get_map() const;
     pointer_t           get_map_item(std::string const & name) const;
 
@@ -160,6 +168,10 @@ public:
     void                error(std::string const & message);
 
 private:
+    friend void         intrusive_ptr_add_ref(Token * token);
+    friend void         intrusive_ptr_release(Token * token);
+
+    std::uint32_t       f_refcount = 0;
     token_t             f_token = token_t::TOK_EOF;
     bool                f_start_of_line = false;
     bool                f_boolean = false;
@@ -173,11 +185,38 @@ private:
     argument_count_t    f_def_args = 0;
     argument_count_t    f_max_args = 0;
     pointer_t           f_declaration = pointer_t();
-    std::string         f_filename = std::string();
+    std::string const * f_filename = nullptr;     // shared by all the tokens of a file
     line_t              f_line = 0;
 };
 
 
+// a token is only used by one thread at a time (the files are read in
+// parallel but the results are only used once all the threads are
+// joined) so a plain counter is enough
+//
+inline void intrusive_ptr_add_ref(Token * token)
+{
+    ++token->f_refcount;
+}
+
+
+inline void intrusive_ptr_release(Token * token)
+{
+    --token->f_refcount;
+    if(token->f_refcount == 0)
+    {
+        delete token;
+    }
+}
+
+
+template<typename ... ARGS>
+Token::pointer_t make_token(ARGS && ... args)
+{
+    return Token::pointer_t(new Token(std::forward<ARGS>(args)...));
+}
+
+
 } // lpp namespace
 
 
@@ -0,0 +1,59 @@
+# lpp -- Logo to binary compiler
+# Copyright (C) 2019  Made to Order Software Corporation
+# https://www.m2osw.com/lpp
+# contact@m2osw.com
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Compile one Logo program with the lpp compiler from the build tree,
+# run it and compare its output against EXPECTED (a regular expression)
+#
+# Usage:
+#   cmake -DLPP=... -DINCLUDE_DIR=... -DLIBRARY_DIR=... -DMAIN_CPP=...
+#         -DSOURCE=... -DBINARY=... -DEXPECTED=... -P run-logo.cmake
+
+execute_process(
+    COMMAND
+        ${LPP}
+            --no-cache
+            --main-cpp ${MAIN_CPP}
+            --rpath ${LIBRARY_DIR}
+            -I ${INCLUDE_DIR}
+            -L ${LIBRARY_DIR}
+            ${SOURCE}
+            -o ${BINARY}
+    RESULT_VARIABLE
+        COMPILE_RESULT
+    OUTPUT_VARIABLE
+        COMPILE_OUTPUT
+    ERROR_VARIABLE
+        COMPILE_OUTPUT
+)
+if(NOT COMPILE_RESULT EQUAL 0)
+    message(FATAL_ERROR "lpp failed compiling ${SOURCE}:\n${COMPILE_OUTPUT}")
+endif()
+
+execute_process(
+    COMMAND
+        ${BINARY}
+    OUTPUT_VARIABLE
+        RUN_OUTPUT
+    ERROR_VARIABLE
+        RUN_OUTPUT
+)
+if(NOT RUN_OUTPUT MATCHES "${EXPECTED}")
+    message(FATAL_ERROR "${SOURCE} output:\n${RUN_OUTPUT}\ndoes not match:\n${EXPECTED}")
+endif()
+
+# vim: ts=4 sw=4 et